@@ -0,0 +1,349 @@
+// rlOpenXR_bench
+// Drives frames through the rlOpenXR frame loop and reports the CPU time spent in each entry point.
+// Results are written as JSON, so CI can diff them between commits.
+//
+// Usage: rlOpenXR_bench [frame count] [output json path]
+//
+// When built together with the mock runtime (RLOPENXR_BUILD_MOCK_RUNTIME), XR_RUNTIME_JSON defaults to it,
+// and the mock runs in non-realtime mode so frames are not paced by the display period.
+
+#include "rlOpenXR.h"
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#define RLOPENXR_BENCH_HEADLESS 1
+#else
+#define RLOPENXR_BENCH_HEADLESS 0
+#endif
+
+typedef enum
+{
+	BENCH_UPDATE,
+	BENCH_UPDATE_CAMERA,
+	BENCH_UPDATE_HANDS,
+	BENCH_BEGIN,
+	BENCH_END,
+	BENCH_ENTRY_POINT_COUNT
+} BenchEntryPoint;
+
+static const char* c_entry_point_names[BENCH_ENTRY_POINT_COUNT] = {
+	"rlOpenXRUpdate",
+	"rlOpenXRUpdateCamera",
+	"rlOpenXRUpdateHands",
+	"rlOpenXRBegin",
+	"rlOpenXREnd",
+};
+
+typedef struct
+{
+	uint64_t p50, p95, p99, min, max;
+	double mean;
+} BenchStats;
+
+typedef struct
+{
+	XrActionSet actionset;
+	XrAction hand_pose_action;
+	XrPath hand_paths[RLOPENXR_HAND_COUNT];
+	XrSpace hand_spaces[RLOPENXR_HAND_COUNT];
+} BenchInputBindings;
+
+static void setup_input_bindings(BenchInputBindings* bindings, RLHand* left, RLHand* right);
+
+// CPU time of the calling thread, so time spent blocking in the runtime is not counted
+static uint64_t cpu_time_ns()
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+	return (uint64_t)clock() * (1000000000ull / CLOCKS_PER_SEC);
+#endif
+}
+
+#define BENCH_TIME(samples, entry_point, frame, call)                        \
+	do                                                                       \
+	{                                                                        \
+		const uint64_t bench_start = cpu_time_ns();                          \
+		call;                                                                \
+		(samples)[(entry_point)][(frame)] = cpu_time_ns() - bench_start;     \
+	} while (0)
+
+static int compare_u64(const void* a, const void* b)
+{
+	const uint64_t lhs = *(const uint64_t*)a;
+	const uint64_t rhs = *(const uint64_t*)b;
+	return (lhs > rhs) - (lhs < rhs);
+}
+
+// Nearest-rank percentile of sorted samples
+static uint64_t percentile(const uint64_t* sorted, int count, double p)
+{
+	int rank = (int)(p * count + 0.999999);
+	if (rank < 1) rank = 1;
+	if (rank > count) rank = count;
+	return sorted[rank - 1];
+}
+
+static BenchStats compute_stats(uint64_t* samples, int count)
+{
+	qsort(samples, count, sizeof(uint64_t), compare_u64);
+
+	double sum = 0.0;
+	for (int i = 0; i < count; ++i)
+	{
+		sum += (double)samples[i];
+	}
+
+	BenchStats stats = { 0 };
+	stats.p50 = percentile(samples, count, 0.50);
+	stats.p95 = percentile(samples, count, 0.95);
+	stats.p99 = percentile(samples, count, 0.99);
+	stats.min = samples[0];
+	stats.max = samples[count - 1];
+	stats.mean = sum / count;
+	return stats;
+}
+
+static bool write_json(const char* path, int frame_count, const BenchStats* stats)
+{
+	FILE* file = fopen(path, "w");
+	if (file == NULL)
+	{
+		printf("rlOpenXR_bench: Could not open '%s' for writing\n", path);
+		return false;
+	}
+
+	fprintf(file, "{\n");
+	fprintf(file, "\t\"frames\": %d,\n", frame_count);
+	fprintf(file, "\t\"unit\": \"ns\",\n");
+	fprintf(file, "\t\"clock\": \"%s\",\n",
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+		"thread_cputime"
+#else
+		"process_clock"
+#endif
+	);
+	fprintf(file, "\t\"entry_points\": {\n");
+	for (int i = 0; i < BENCH_ENTRY_POINT_COUNT; ++i)
+	{
+		const BenchStats* s = &stats[i];
+		fprintf(file, "\t\t\"%s\": { \"p50\": %llu, \"p95\": %llu, \"p99\": %llu, \"min\": %llu, \"max\": %llu, \"mean\": %.1f }%s\n",
+			c_entry_point_names[i],
+			(unsigned long long)s->p50, (unsigned long long)s->p95, (unsigned long long)s->p99,
+			(unsigned long long)s->min, (unsigned long long)s->max, s->mean,
+			i + 1 < BENCH_ENTRY_POINT_COUNT ? "," : "");
+	}
+	fprintf(file, "\t}\n");
+	fprintf(file, "}\n");
+
+	fclose(file);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const int frame_count = argc > 1 ? atoi(argv[1]) : 5000;
+	const char* output_path = argc > 2 ? argv[2] : "rlOpenXR_bench.json";
+	const int warmup_frame_limit = 1000; // Frames allowed for the session to become focused
+
+	if (frame_count <= 0)
+	{
+		printf("Usage: rlOpenXR_bench [frame count] [output json path]\n");
+		return 1;
+	}
+
+#if defined(RLOPENXR_BENCH_MOCK_RUNTIME_JSON)
+	// Don't override a runtime picked by the user
+	setenv("XR_RUNTIME_JSON", RLOPENXR_BENCH_MOCK_RUNTIME_JSON, 0);
+	setenv("RLOPENXR_MOCK_REALTIME", "0", 0);
+#endif
+
+	SetTraceLogLevel(LOG_WARNING);
+
+#if RLOPENXR_BENCH_HEADLESS
+	rlOpenXRSetConfigFlags(RLOPENXR_FLAG_HEADLESS);
+#else
+	SetConfigFlags(FLAG_WINDOW_HIDDEN);
+	InitWindow(640, 480, "rlOpenXR - Bench");
+#endif
+	SetTargetFPS(-1);
+
+	if (!rlOpenXRSetup())
+	{
+		printf("Failed to initialise rlOpenXR!\n");
+		return 1;
+	}
+
+	Camera camera = { 0 };
+	camera.position = (Vector3){ 0.0f, 1.6f, 0.0f };
+	camera.target = (Vector3){ 0.0f, 1.6f, -1.0f };
+	camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+	camera.fovy = 45.0f;
+	camera.projection = CAMERA_PERSPECTIVE;
+
+	RLHand left_hand = { 0 };
+	left_hand.handedness = RLOPENXR_HAND_LEFT;
+	RLHand right_hand = { 0 };
+	right_hand.handedness = RLOPENXR_HAND_RIGHT;
+
+	BenchInputBindings bindings = { 0 };
+	setup_input_bindings(&bindings, &left_hand, &right_hand);
+
+	// Warm up until the session is running, so only steady state frames are measured
+	int warmup_frames = 0;
+	while (rlOpenXRData()->session_state != XR_SESSION_STATE_FOCUSED && warmup_frames < warmup_frame_limit)
+	{
+		rlOpenXRUpdate();
+		if (rlOpenXRBegin())
+		{
+			ClearBackground(BLACK);
+		}
+		rlOpenXREnd();
+		++warmup_frames;
+	}
+	if (rlOpenXRData()->session_state != XR_SESSION_STATE_FOCUSED)
+	{
+		printf("rlOpenXR_bench: Session did not become focused after %d frames\n", warmup_frames);
+		rlOpenXRShutdown();
+		return 1;
+	}
+
+	uint64_t* samples[BENCH_ENTRY_POINT_COUNT];
+	for (int i = 0; i < BENCH_ENTRY_POINT_COUNT; ++i)
+	{
+		samples[i] = (uint64_t*)calloc(frame_count, sizeof(uint64_t));
+		assert(samples[i] != NULL);
+	}
+
+	for (int frame = 0; frame < frame_count; ++frame)
+	{
+		BENCH_TIME(samples, BENCH_UPDATE, frame, rlOpenXRUpdate());
+
+		rlOpenXRSyncSingleActionSet(bindings.actionset);
+
+		BENCH_TIME(samples, BENCH_UPDATE_HANDS, frame, rlOpenXRUpdateHands(&left_hand, &right_hand));
+		BENCH_TIME(samples, BENCH_UPDATE_CAMERA, frame, rlOpenXRUpdateCamera(&camera));
+
+		bool rendering;
+		BENCH_TIME(samples, BENCH_BEGIN, frame, rendering = rlOpenXRBegin());
+		if (rendering)
+		{
+			ClearBackground(BLUE);
+
+			BeginMode3D(camera);
+
+				DrawCube(left_hand.position, 0.1f, 0.1f, 0.1f, ORANGE);
+				DrawCube(right_hand.position, 0.1f, 0.1f, 0.1f, PINK);
+				DrawCube((Vector3){ -3, 0, 0 }, 2.0f, 2.0f, 2.0f, RED);
+				DrawGrid(10, 1.0f);
+
+			EndMode3D();
+		}
+		BENCH_TIME(samples, BENCH_END, frame, rlOpenXREnd());
+	}
+
+	BenchStats stats[BENCH_ENTRY_POINT_COUNT];
+	for (int i = 0; i < BENCH_ENTRY_POINT_COUNT; ++i)
+	{
+		stats[i] = compute_stats(samples[i], frame_count);
+		printf("%-22s p50 %8llu ns  p95 %8llu ns  p99 %8llu ns\n", c_entry_point_names[i],
+			(unsigned long long)stats[i].p50, (unsigned long long)stats[i].p95, (unsigned long long)stats[i].p99);
+		free(samples[i]);
+	}
+
+	const bool written = write_json(output_path, frame_count, stats);
+
+	rlOpenXRShutdown();
+
+#if !RLOPENXR_BENCH_HEADLESS
+	CloseWindow();
+#endif
+
+	return written ? 0 : 1;
+}
+
+static void setup_input_bindings(BenchInputBindings* bindings, RLHand* left, RLHand* right)
+{
+	const RLOpenXRData* xr = rlOpenXRData();
+
+	XrResult result = xrStringToPath(xr->instance, "/user/hand/left", &bindings->hand_paths[RLOPENXR_HAND_LEFT]);
+	assert(XR_SUCCEEDED(result));
+	result = xrStringToPath(xr->instance, "/user/hand/right", &bindings->hand_paths[RLOPENXR_HAND_RIGHT]);
+	assert(XR_SUCCEEDED(result));
+
+	XrActionSetCreateInfo actionset_info = { 0 };
+	actionset_info.type = XR_TYPE_ACTION_SET_CREATE_INFO;
+	strncpy(actionset_info.actionSetName, "rlopenxr_bench_actionset", XR_MAX_ACTION_SET_NAME_SIZE - 1);
+	strncpy(actionset_info.localizedActionSetName, "rlOpenXR Bench ActionSet", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE - 1);
+	result = xrCreateActionSet(xr->instance, &actionset_info, &bindings->actionset);
+	assert(XR_SUCCEEDED(result));
+
+	XrActionCreateInfo action_info = { 0 };
+	action_info.type = XR_TYPE_ACTION_CREATE_INFO;
+	strncpy(action_info.actionName, "handpose", XR_MAX_ACTION_NAME_SIZE - 1);
+	strncpy(action_info.localizedActionName, "Hand Pose", XR_MAX_LOCALIZED_ACTION_NAME_SIZE - 1);
+	action_info.actionType = XR_ACTION_TYPE_POSE_INPUT;
+	action_info.countSubactionPaths = RLOPENXR_HAND_COUNT;
+	action_info.subactionPaths = bindings->hand_paths;
+	result = xrCreateAction(bindings->actionset, &action_info, &bindings->hand_pose_action);
+	assert(XR_SUCCEEDED(result));
+
+	for (int hand = 0; hand < RLOPENXR_HAND_COUNT; hand++)
+	{
+		XrActionSpaceCreateInfo action_space_info = { 0 };
+		action_space_info.type = XR_TYPE_ACTION_SPACE_CREATE_INFO;
+		action_space_info.action = bindings->hand_pose_action;
+		action_space_info.subactionPath = bindings->hand_paths[hand];
+		action_space_info.poseInActionSpace = (XrPosef){ { 0, 0, 0, 1 }, { 0, 0, 0 } };
+		result = xrCreateActionSpace(xr->session, &action_space_info, &bindings->hand_spaces[hand]);
+		assert(XR_SUCCEEDED(result));
+	}
+
+	XrPath grip_pose_path[RLOPENXR_HAND_COUNT] = { 0 };
+	xrStringToPath(xr->instance, "/user/hand/left/input/grip/pose", &grip_pose_path[RLOPENXR_HAND_LEFT]);
+	xrStringToPath(xr->instance, "/user/hand/right/input/grip/pose", &grip_pose_path[RLOPENXR_HAND_RIGHT]);
+
+	XrPath interaction_profile_path;
+	result = xrStringToPath(xr->instance, "/interaction_profiles/khr/simple_controller", &interaction_profile_path);
+	assert(XR_SUCCEEDED(result));
+
+	XrActionSuggestedBinding action_suggested_bindings[] = {
+		{ bindings->hand_pose_action, grip_pose_path[RLOPENXR_HAND_LEFT] },
+		{ bindings->hand_pose_action, grip_pose_path[RLOPENXR_HAND_RIGHT] }
+	};
+
+	XrInteractionProfileSuggestedBinding suggested_bindings = { 0 };
+	suggested_bindings.type = XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING;
+	suggested_bindings.interactionProfile = interaction_profile_path;
+	suggested_bindings.countSuggestedBindings = sizeof(action_suggested_bindings) / sizeof(action_suggested_bindings[0]);
+	suggested_bindings.suggestedBindings = action_suggested_bindings;
+	result = xrSuggestInteractionProfileBindings(xr->instance, &suggested_bindings);
+	assert(XR_SUCCEEDED(result));
+
+	XrSessionActionSetsAttachInfo actionset_attach_info = { 0 };
+	actionset_attach_info.type = XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO;
+	actionset_attach_info.countActionSets = 1;
+	actionset_attach_info.actionSets = &bindings->actionset;
+	result = xrAttachSessionActionSets(xr->session, &actionset_attach_info);
+	assert(XR_SUCCEEDED(result));
+	(void)result;
+
+	RLHand* hands[RLOPENXR_HAND_COUNT] = { left, right };
+	for (int i = 0; i < RLOPENXR_HAND_COUNT; ++i)
+	{
+		hands[i]->hand_pose_action = bindings->hand_pose_action;
+		hands[i]->hand_pose_subpath = bindings->hand_paths[i];
+		hands[i]->hand_pose_space = bindings->hand_spaces[i];
+	}
+}
@@ -97,8 +97,11 @@ int main()
                 float right_hand_angle;
                 QuaternionToAxisAngle(right_hand.orientation, &right_hand_axis, &right_hand_angle);
 
-                DrawModelEx(hand_model, left_hand.position, left_hand_axis, left_hand_angle * RAD2DEG, Vector3One(), ORANGE);
-                DrawModelEx(hand_model, right_hand.position, right_hand_axis, right_hand_angle * RAD2DEG, Vector3One(), PINK);
+                // The runtime's controller models are used when it provides them (XR_MSFT_controller_model), cubes otherwise
+                if (!rlOpenXRDrawControllerModel(&left_hand, WHITE))
+                    rlOpenXRDrawModelEx(hand_model, left_hand.position, left_hand_axis, left_hand_angle * RAD2DEG, Vector3One(), ORANGE);
+                if (!rlOpenXRDrawControllerModel(&right_hand, WHITE))
+                    rlOpenXRDrawModelEx(hand_model, right_hand.position, right_hand_axis, right_hand_angle * RAD2DEG, Vector3One(), PINK);
 
 				// Draw Scene
 				DrawCube((Vector3) { -3, 0, 0 }, 2.0f, 2.0f, 2.0f, RED);
@@ -144,10 +147,8 @@ void setup_input_bindings(XRInputBindings* bindings)
 	XrActionSetCreateInfo actionset_info = { 0 };
 	actionset_info.type = XR_TYPE_ACTION_SET_CREATE_INFO;
 	actionset_info.next = NULL;
-	strncpy_s(actionset_info.actionSetName, XR_MAX_ACTION_SET_NAME_SIZE, 
-		"rlopenxr_hello_hands_actionset", XR_MAX_ACTION_SET_NAME_SIZE);
-	strncpy_s(actionset_info.localizedActionSetName, XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE, 
-		"OpenXR Hello Hands ActionSet", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE);
+	strncpy(actionset_info.actionSetName, "rlopenxr_hello_hands_actionset", XR_MAX_ACTION_SET_NAME_SIZE - 1);
+	strncpy(actionset_info.localizedActionSetName, "OpenXR Hello Hands ActionSet", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE - 1);
 	actionset_info.priority = 0;
 
 	result = xrCreateActionSet(xr->instance, &actionset_info, &bindings->actionset);
@@ -157,13 +158,11 @@ void setup_input_bindings(XRInputBindings* bindings)
 		XrActionCreateInfo action_info = { 0 };
 		action_info.type = XR_TYPE_ACTION_CREATE_INFO;
 		action_info.next = NULL;
-		strncpy_s(action_info.actionName, XR_MAX_ACTION_NAME_SIZE, 
-			"handpose", XR_MAX_ACTION_NAME_SIZE);
+		strncpy(action_info.actionName, "handpose", XR_MAX_ACTION_NAME_SIZE - 1);
 		action_info.actionType = XR_ACTION_TYPE_POSE_INPUT;
 		action_info.countSubactionPaths = RLOPENXR_HAND_COUNT;
 		action_info.subactionPaths = bindings->hand_paths;
-		strncpy_s(action_info.localizedActionName, XR_MAX_LOCALIZED_ACTION_NAME_SIZE, 
-			"Hand Pose", XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
+		strncpy(action_info.localizedActionName, "Hand Pose", XR_MAX_LOCALIZED_ACTION_NAME_SIZE - 1);
 
 		result = xrCreateAction(bindings->actionset, &action_info, &bindings->hand_pose_action);
 		assert(XR_SUCCEEDED(result) && "Failed to create hand pose action");
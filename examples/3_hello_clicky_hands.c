@@ -5,23 +5,16 @@
 
 #include <assert.h>
 #include <stdio.h>
-#include <string.h>
 
 typedef struct
 {
-	XrActionSet actionset;
+	int actionset;
 
-	XrAction hand_pose_action;
-	XrPath hand_sub_paths[2];
-	XrSpace hand_spaces[2];
-
-	XrAction hand_activate_action;
+	int hand_pose_action;
+	int hand_activate_action;
 } XRInputBindings;
 
 void setup_input_bindings(XRInputBindings* bindings);
-void assign_hand_input_bindings(XRInputBindings* bindings, RLHand* left, RLHand* right);
-
-float get_action_value_float(XrAction action, XrPath sub_path);
 
 int main()
 {
@@ -50,9 +43,10 @@ int main()
 
 	RLHand left_hand = { 0 };
 	left_hand.handedness = RLOPENXR_HAND_LEFT;
+	rlOpenXRSetHandPoseAction(&left_hand, bindings.hand_pose_action);
 	RLHand right_hand = { 0 };
 	right_hand.handedness = RLOPENXR_HAND_RIGHT;
-	assign_hand_input_bindings(&bindings, &left_hand, &right_hand);
+	rlOpenXRSetHandPoseAction(&right_hand, bindings.hand_pose_action);
 
 	Model hand_model = LoadModelFromMesh(GenMeshCube(0.2f, 0.2f, 0.2f));
 
@@ -71,9 +65,7 @@ int main()
 
 		rlOpenXRUpdate(); // Update OpenXR State
 						  // Should be called at the start of each frame before other rlOpenXR calls.
-
-		rlOpenXRSyncSingleActionSet(bindings.actionset); // Simple utility function for simple apps with 1 action set.
-														 // xrSyncAction will activate action sets for use.
+						  // Also syncs the action sets created with rlOpenXRCreateActionSet()
 
 		rlOpenXRUpdateHands(&left_hand, &right_hand);
 
@@ -101,8 +93,8 @@ int main()
 				float right_hand_angle;
 				QuaternionToAxisAngle(right_hand.orientation, &right_hand_axis, &right_hand_angle);
 
-				float left_value = get_action_value_float(bindings.hand_activate_action, bindings.hand_sub_paths[RLOPENXR_HAND_LEFT]);
-				float right_value = get_action_value_float(bindings.hand_activate_action, bindings.hand_sub_paths[RLOPENXR_HAND_RIGHT]);
+				float left_value = rlOpenXRGetActionState(bindings.hand_activate_action, RLOPENXR_HAND_LEFT)->value;
+				float right_value = rlOpenXRGetActionState(bindings.hand_activate_action, RLOPENXR_HAND_RIGHT)->value;
 				Color left_color = left_value > 0.75f ? GREEN : ORANGE;
 				Color right_color = right_value > 0.75f ? GREEN : YELLOW;
 
@@ -144,162 +136,31 @@ int main()
 
 void setup_input_bindings(XRInputBindings* bindings)
 {
-	const RLOpenXRData* xr = rlOpenXRData();
-
-	XrResult result = xrStringToPath(xr->instance, "/user/hand/left", &bindings->hand_sub_paths[RLOPENXR_HAND_LEFT]);
-	assert(XR_SUCCEEDED(result) && "Could not convert Left hand string to path.");
-	result = xrStringToPath(xr->instance, "/user/hand/right", &bindings->hand_sub_paths[RLOPENXR_HAND_RIGHT]);
-	assert(XR_SUCCEEDED(result) && "Could not convert Right hand string to path.");
-
-	XrActionSetCreateInfo actionset_info = { 0 };
-	actionset_info.type = XR_TYPE_ACTION_SET_CREATE_INFO;
-	actionset_info.next = NULL;
-	strncpy_s(actionset_info.actionSetName, XR_MAX_ACTION_SET_NAME_SIZE, 
-		"rlopenxr_hello_hands_actionset", XR_MAX_ACTION_SET_NAME_SIZE);
-	strncpy_s(actionset_info.localizedActionSetName, XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE, 
-		"OpenXR Hello Hands ActionSet", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE);
-	actionset_info.priority = 0;
-
-	result = xrCreateActionSet(xr->instance, &actionset_info, &bindings->actionset);
-	assert(XR_SUCCEEDED(result) && "Failed to create actionset.");
-
-	{
-		XrActionCreateInfo action_info = { 0 };
-		action_info.type = XR_TYPE_ACTION_CREATE_INFO;
-		action_info.next = NULL;
-		strncpy_s(action_info.actionName, XR_MAX_ACTION_NAME_SIZE, 
-			"handpose", XR_MAX_ACTION_NAME_SIZE);
-		action_info.actionType = XR_ACTION_TYPE_POSE_INPUT;
-		action_info.countSubactionPaths = RLOPENXR_HAND_COUNT;
-		action_info.subactionPaths = bindings->hand_sub_paths;
-		strncpy_s(action_info.localizedActionName, XR_MAX_LOCALIZED_ACTION_NAME_SIZE, 
-			"Hand Pose", XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
-
-		result = xrCreateAction(bindings->actionset, &action_info, &bindings->hand_pose_action);
-		assert(XR_SUCCEEDED(result) && "Failed to create hand pose action");
-	}
-
-	{
-		XrActionCreateInfo action_info = { 0 };
-		action_info.type = XR_TYPE_ACTION_CREATE_INFO;
-		action_info.next = NULL;
-		strncpy_s(action_info.actionName, XR_MAX_ACTION_NAME_SIZE, 
-			"activate", XR_MAX_ACTION_NAME_SIZE);
-		action_info.actionType = XR_ACTION_TYPE_FLOAT_INPUT;
-		action_info.countSubactionPaths = RLOPENXR_HAND_COUNT;
-		action_info.subactionPaths = bindings->hand_sub_paths;
-		strncpy_s(action_info.localizedActionName, XR_MAX_LOCALIZED_ACTION_NAME_SIZE, 
-			"Activate", XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
-
-		result = xrCreateAction(bindings->actionset, &action_info, &bindings->hand_activate_action);
-		assert(XR_SUCCEEDED(result) && "Failed to create hand activate action");
-	}
-
-	// poses can't be queried directly, we need to create a space for each
-	for (int hand = 0; hand < RLOPENXR_HAND_COUNT; hand++) {
-		XrPosef identity_pose = { { 0, 0, 0, 1}, {0, 0, 0} };
-
-		XrActionSpaceCreateInfo action_space_info = { 0 };
-		action_space_info.type = XR_TYPE_ACTION_SPACE_CREATE_INFO;
-		action_space_info.next = NULL;
-		action_space_info.action = bindings->hand_pose_action;
-		action_space_info.subactionPath = bindings->hand_sub_paths[hand];
-		action_space_info.poseInActionSpace = identity_pose;
-
-		result = xrCreateActionSpace(xr->session, &action_space_info, &bindings->hand_spaces[hand]);
-		assert(XR_SUCCEEDED(result) && "failed to create hand %d pose space");
-	}
+	bindings->actionset = rlOpenXRCreateActionSet("rlopenxr_hello_hands_actionset", "OpenXR Hello Hands ActionSet", 0);
+	assert(bindings->actionset >= 0 && "Failed to create actionset.");
 
-	XrPath grip_pose_paths[2] = { 0 };
-	xrStringToPath(xr->instance, "/user/hand/left/input/grip/pose", &grip_pose_paths[RLOPENXR_HAND_LEFT]);
-	xrStringToPath(xr->instance, "/user/hand/right/input/grip/pose", &grip_pose_paths[RLOPENXR_HAND_RIGHT]);
-
-	XrPath activate_paths[2] = { 0 };
-	xrStringToPath(xr->instance, "/user/hand/left/input/trigger/value", &activate_paths[RLOPENXR_HAND_LEFT]);
-	xrStringToPath(xr->instance, "/user/hand/right/input/trigger/value", &activate_paths[RLOPENXR_HAND_RIGHT]);
+	const bool per_hand = true;
+	bindings->hand_pose_action = rlOpenXRCreateAction(bindings->actionset, "handpose", "Hand Pose", XR_ACTION_TYPE_POSE_INPUT, per_hand);
+	assert(bindings->hand_pose_action >= 0 && "Failed to create hand pose action");
+	bindings->hand_activate_action = rlOpenXRCreateAction(bindings->actionset, "activate", "Activate", XR_ACTION_TYPE_FLOAT_INPUT, per_hand);
+	assert(bindings->hand_activate_action >= 0 && "Failed to create hand activate action");
 
 	// khr/simple_controller Interaction Profile
-	{
-		XrPath interaction_profile_path;
-		result = xrStringToPath(xr->instance, "/interaction_profiles/khr/simple_controller", &interaction_profile_path);
-		assert(XR_SUCCEEDED(result) && "failed to get interaction profile");
-
-		XrActionSuggestedBinding action_suggested_bindings[] = {
-			{ bindings->hand_pose_action, grip_pose_paths[RLOPENXR_HAND_LEFT] },
-			{ bindings->hand_pose_action, grip_pose_paths[RLOPENXR_HAND_RIGHT] },
-		};
-		const int action_suggested_bindings_count = sizeof(action_suggested_bindings) / sizeof(action_suggested_bindings[0]);
-
-		XrInteractionProfileSuggestedBinding suggested_bindings = { 0 };
-		suggested_bindings.type = XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING;
-		suggested_bindings.next = NULL;
-		suggested_bindings.interactionProfile = interaction_profile_path;
-		suggested_bindings.countSuggestedBindings = action_suggested_bindings_count;
-		suggested_bindings.suggestedBindings = action_suggested_bindings;
-
-		result = xrSuggestInteractionProfileBindings(xr->instance, &suggested_bindings);
-		assert(XR_SUCCEEDED(result) && "failed to suggest bindings for khr/simple_controller");
-	}
+	const char* simple_controller = "/interaction_profiles/khr/simple_controller";
+	bool suggested = true;
+	suggested &= rlOpenXRSuggestActionBinding(bindings->hand_pose_action, simple_controller, "/user/hand/left/input/grip/pose");
+	suggested &= rlOpenXRSuggestActionBinding(bindings->hand_pose_action, simple_controller, "/user/hand/right/input/grip/pose");
 
 	// oculus/touch_controller Interaction Profile
-	{
-		XrPath interaction_profile_path;
-		result = xrStringToPath(xr->instance, "/interaction_profiles/oculus/touch_controller", &interaction_profile_path);
-		assert(XR_SUCCEEDED(result) && "failed to get interaction profile");
-
-		XrActionSuggestedBinding action_suggested_bindings[] = {
-			{ bindings->hand_pose_action, grip_pose_paths[RLOPENXR_HAND_LEFT]},
-			{ bindings->hand_pose_action, grip_pose_paths[RLOPENXR_HAND_RIGHT]},
-			{ bindings->hand_activate_action, activate_paths[RLOPENXR_HAND_LEFT] },
-			{ bindings->hand_activate_action, activate_paths[RLOPENXR_HAND_RIGHT] },
-		};
-		const int action_suggested_bindings_count = sizeof(action_suggested_bindings) / sizeof(action_suggested_bindings[0]);
-
-		XrInteractionProfileSuggestedBinding suggested_bindings = { 0 };
-		suggested_bindings.type = XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING;
-		suggested_bindings.next = NULL;
-		suggested_bindings.interactionProfile = interaction_profile_path;
-		suggested_bindings.countSuggestedBindings = action_suggested_bindings_count;
-		suggested_bindings.suggestedBindings = action_suggested_bindings;
-
-		result = xrSuggestInteractionProfileBindings(xr->instance, &suggested_bindings);
-		assert(XR_SUCCEEDED(result) && "failed to suggest bindings for oculus/touch_controller");
-	}
-
-	XrSessionActionSetsAttachInfo actionset_attach_info = { 0 };
-	actionset_attach_info.type = XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO;
-	actionset_attach_info.next = NULL;
-	actionset_attach_info.countActionSets = 1;
-	actionset_attach_info.actionSets = &bindings->actionset;
-	result = xrAttachSessionActionSets(xr->session, &actionset_attach_info);
-	assert(XR_SUCCEEDED(result) && "failed to attach action set");
-}
-
-void assign_hand_input_bindings(XRInputBindings* bindings, RLHand* left, RLHand* right)
-{
-	RLHand* hands[2] = { left, right };
-
-	for (int i = 0; i < RLOPENXR_HAND_COUNT; ++i)
-	{
-		hands[i]->hand_pose_action = bindings->hand_pose_action;
-		hands[i]->hand_pose_subpath = bindings->hand_sub_paths[i];
-		hands[i]->hand_pose_space = bindings->hand_spaces[i];
-	}
-}
-
-float get_action_value_float(XrAction action, XrPath sub_path)
-{
-	XrActionStateGetInfo activate_state_get_info;
-	activate_state_get_info.type = XR_TYPE_ACTION_STATE_GET_INFO;
-	activate_state_get_info.next = NULL;
-	activate_state_get_info.action = action;
-	activate_state_get_info.subactionPath = sub_path;
-
-	XrActionStateFloat activate_state;
-	activate_state.type = XR_TYPE_ACTION_STATE_FLOAT;
-	activate_state.next = NULL;
-	XrResult result = xrGetActionStateFloat(rlOpenXRData()->session, &activate_state_get_info, &activate_state);
-	assert(XR_SUCCEEDED(result) && "failed to get action state as a float");
-
-	return activate_state.currentState;
+	const char* touch_controller = "/interaction_profiles/oculus/touch_controller";
+	suggested &= rlOpenXRSuggestActionBinding(bindings->hand_pose_action, touch_controller, "/user/hand/left/input/grip/pose");
+	suggested &= rlOpenXRSuggestActionBinding(bindings->hand_pose_action, touch_controller, "/user/hand/right/input/grip/pose");
+	suggested &= rlOpenXRSuggestActionBinding(bindings->hand_activate_action, touch_controller, "/user/hand/left/input/trigger/value");
+	suggested &= rlOpenXRSuggestActionBinding(bindings->hand_activate_action, touch_controller, "/user/hand/right/input/trigger/value");
+	assert(suggested && "failed to suggest action bindings");
+	(void)suggested;
+
+	const bool attached = rlOpenXRAttachActionSets();
+	assert(attached && "failed to attach action set");
+	(void)attached;
 }
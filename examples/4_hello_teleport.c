@@ -238,10 +238,8 @@ void setup_input_bindings(XRInputBindings* bindings)
 	XrActionSetCreateInfo actionset_info = { 0 };
 	actionset_info.type = XR_TYPE_ACTION_SET_CREATE_INFO;
 	actionset_info.next = NULL;
-	strncpy_s(actionset_info.actionSetName, XR_MAX_ACTION_SET_NAME_SIZE, 
-		"rlopenxr_hello_hands_actionset", XR_MAX_ACTION_SET_NAME_SIZE);
-	strncpy_s(actionset_info.localizedActionSetName, XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE,
-		"OpenXR Hello Hands ActionSet", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE);
+	strncpy(actionset_info.actionSetName, "rlopenxr_hello_hands_actionset", XR_MAX_ACTION_SET_NAME_SIZE - 1);
+	strncpy(actionset_info.localizedActionSetName, "OpenXR Hello Hands ActionSet", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE - 1);
 	actionset_info.priority = 0;
 
 	result = xrCreateActionSet(xr->instance, &actionset_info, &bindings->actionset);
@@ -251,13 +249,11 @@ void setup_input_bindings(XRInputBindings* bindings)
 		XrActionCreateInfo action_info = { 0 };
 		action_info.type = XR_TYPE_ACTION_CREATE_INFO;
 		action_info.next = NULL;
-		strncpy_s(action_info.actionName, XR_MAX_ACTION_NAME_SIZE, 
-			"handpose", XR_MAX_ACTION_NAME_SIZE);
+		strncpy(action_info.actionName, "handpose", XR_MAX_ACTION_NAME_SIZE - 1);
 		action_info.actionType = XR_ACTION_TYPE_POSE_INPUT;
 		action_info.countSubactionPaths = RLOPENXR_HAND_COUNT;
 		action_info.subactionPaths = bindings->hand_sub_paths;
-		strncpy_s(action_info.localizedActionName, XR_MAX_LOCALIZED_ACTION_NAME_SIZE, 
-			"Hand Pose", XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
+		strncpy(action_info.localizedActionName, "Hand Pose", XR_MAX_LOCALIZED_ACTION_NAME_SIZE - 1);
 
 		result = xrCreateAction(bindings->actionset, &action_info, &bindings->hand_pose_action);
 		assert(XR_SUCCEEDED(result) && "Failed to create hand pose action");
@@ -267,13 +263,11 @@ void setup_input_bindings(XRInputBindings* bindings)
 		XrActionCreateInfo action_info = { 0 };
 		action_info.type = XR_TYPE_ACTION_CREATE_INFO;
 		action_info.next = NULL;
-		strncpy_s(action_info.actionName, XR_MAX_ACTION_NAME_SIZE, 
-			"activate", XR_MAX_ACTION_NAME_SIZE);
+		strncpy(action_info.actionName, "activate", XR_MAX_ACTION_NAME_SIZE - 1);
 		action_info.actionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
 		action_info.countSubactionPaths = RLOPENXR_HAND_COUNT;
 		action_info.subactionPaths = bindings->hand_sub_paths;
-		strncpy_s(action_info.localizedActionName, XR_MAX_LOCALIZED_ACTION_NAME_SIZE, 
-			"Activate", XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
+		strncpy(action_info.localizedActionName, "Activate", XR_MAX_LOCALIZED_ACTION_NAME_SIZE - 1);
 
 		result = xrCreateAction(bindings->actionset, &action_info, &bindings->hand_teleport_action);
 		assert(XR_SUCCEEDED(result) && "Failed to create hand activate action");
@@ -0,0 +1,30 @@
+#pragma once
+#include "openxr/openxr.h"
+// raylib.h collides with Xlib.h (Font, Camera, ...),
+// So the GLX / EGL parts are kept behind these wrappers and the graphics binding is handed out as an opaque XrBaseInStructure.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+	RLOPENXR_LINUX_GL_BINDING_NONE = 0, // No GL context is current on the calling thread
+	RLOPENXR_LINUX_GL_BINDING_XLIB,     // GLX context, uses XR_KHR_opengl_enable's XrGraphicsBindingOpenGLXlibKHR
+	RLOPENXR_LINUX_GL_BINDING_EGL       // EGL context, uses XR_MNDX_egl_enable's XrGraphicsBindingEGLMNDX
+} RLOpenXRLinuxGLBinding;
+
+// Wrapped GLX / EGL functions
+RLOpenXRLinuxGLBinding wrapped_GetCurrentGLBinding();
+const XrBaseInStructure* wrapped_XrGraphicsBindingFromCurrentContext(RLOpenXRLinuxGLBinding binding); // Pointer stays valid until the next call
+XrTime wrapped_XrTimeFromTimespecMonotonic(XrInstance instance, void* xrConvertTimespecTimeToTimeKHR_funcptr);
+void* wrapped_glGetProcAddress(const char* name); // GL extension functions of the current GLX or EGL context
+
+// Headless EGL context, for machines without a display server (eg, Mesa llvmpipe on build farms)
+bool wrapped_eglCreateHeadlessContext(int width, int height); // Creates a pbuffer backed GL 3.3 core context and makes it current
+void wrapped_eglDestroyHeadlessContext();
+void* wrapped_eglGetProcAddress(const char* name);
+
+#ifdef __cplusplus
+}
+#endif
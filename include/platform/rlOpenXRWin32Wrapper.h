@@ -21,6 +21,7 @@ typedef int BOOL;
 HDC wrapped_wglGetCurrentDC();
 HGLRC wrapped_wglGetCurrentContext();
 BOOL wrapped_wglMakeCurrent(HDC hDC, HGLRC hGLRC);
+void* wrapped_glGetProcAddress(const char* name); // GL extension functions of the current context
 XrTime wrapped_XrTimeFromQueryPerformanceCounter(XrInstance instance, void* xrConvertWin32PerformanceCounterToTimeKHR_funcptr);
 
 #ifdef __cplusplus
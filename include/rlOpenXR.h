@@ -12,6 +12,75 @@ typedef enum { RLOPENXR_EYE_LEFT = 0, RLOPENXR_EYE_RIGHT = 1, RLOPENXR_EYE_BOTH
 
 typedef enum { RLOPENXR_HAND_LEFT, RLOPENXR_HAND_RIGHT, RLOPENXR_HAND_COUNT } RLOpenXRHandEnum;
 
+typedef enum { RLOPENXR_LAYER_SPACE_PLAY, RLOPENXR_LAYER_SPACE_VIEW } RLOpenXRLayerSpace; // View space layers follow the head
+
+// Setup flags, set with rlOpenXRSetConfigFlags() before calling rlOpenXRSetup()
+typedef enum
+{
+	RLOPENXR_FLAG_HEADLESS = 0x00000001, // Create an offscreen EGL context instead of using the raylib window (Linux only). Do not call InitWindow().
+	RLOPENXR_FLAG_PIPELINED_WAIT_FRAME = 0x00000002, // Call xrWaitFrame() on a separate thread, so simulation after rlOpenXRUpdate() overlaps the wait.
+	                                                 // rlOpenXRBegin() then blocks until the frame is ready, and has to be called every frame.
+	RLOPENXR_FLAG_DYNAMIC_RESOLUTION = 0x00000004, // Scale the rendered resolution every frame to keep the GPU frame time within the display period.
+	                                               // See rlOpenXRSetResolutionScaleRange()
+	RLOPENXR_FLAG_MULTIVIEW = 0x00000008, // Render both eyes in one draw into layered swapchains with GL_OVR_multiview2, falls back to side by side without it.
+	                                      // Shaders used between rlOpenXRBegin() and rlOpenXREnd() have to be multiview aware, see rlOpenXRGetMultiviewShader()
+	                                      // rlgl's batched draws (DrawCube(), DrawLine3D(), ...) have to be made in BeginMode3D() with the camera passed to rlOpenXRUpdateCamera(),
+	                                      // rlOpenXRDrawMesh() / rlOpenXRDrawModel() work with any projection.
+	RLOPENXR_FLAG_SPACE_WARP = 0x00000010, // Submit motion vectors with XR_FB_space_warp, the runtime then halves the frame rate and synthesizes every other frame.
+	                                       // Needs depth. Motion vectors come from head motion only. See rlOpenXRSetSpaceWarpActive()
+} RLOpenXRConfigFlags;
+
+// Compile time maximum set with the RLOPENXR_LOG_LEVEL CMake cache variable, see rlOpenXRSetLogLevel()
+typedef enum
+{
+	RLOPENXR_LOG_LEVEL_NONE,
+	RLOPENXR_LOG_LEVEL_ERROR,
+	RLOPENXR_LOG_LEVEL_WARNING,
+	RLOPENXR_LOG_LEVEL_INFO,
+	RLOPENXR_LOG_LEVEL_DEBUG,
+} RLOpenXRLogLevel;
+
+typedef struct
+{
+	float min;
+	float avg;
+	float max;
+} RLOpenXRStat;
+
+// Frame pacing over the last frames, see rlOpenXRGetFrameStats()
+typedef struct
+{
+	int frame_count; // Frames in the rolling window
+
+	RLOpenXRStat display_period_ms;     // XrFrameState::predictedDisplayPeriod
+	RLOpenXRStat display_time_delta_ms; // Delta between consecutive XrFrameState::predictedDisplayTime
+	RLOpenXRStat wait_frame_ms;         // Time blocked in xrWaitFrame()
+	RLOpenXRStat begin_to_end_ms;       // Time between rlOpenXRBegin() and rlOpenXREnd()
+
+	int dropped_frames;        // Display periods skipped between consecutive frames
+	int repeated_frames;       // Frames predicted for (almost) the same display time as the previous frame
+	float should_render_ratio; // Fraction of frames where XrFrameState::shouldRender was true
+} RLOpenXRFrameStats;
+
+#define RLOPENXR_MAX_GPU_ZONES 16
+#define RLOPENXR_GPU_ZONE_NAME_SIZE 32
+
+typedef struct
+{
+	char name[RLOPENXR_GPU_ZONE_NAME_SIZE];
+	float gpu_ms;
+	int depth; // Nesting level, 0 for top level zones
+} RLOpenXRGpuZone;
+
+// GPU time of a frame rendered a few frames ago, see rlOpenXRGetGpuTimings()
+typedef struct
+{
+	bool valid;         // false until the first results are read back
+	float frame_gpu_ms; // rlOpenXRBegin() to rlOpenXREnd(), both eyes
+	int zone_count;
+	RLOpenXRGpuZone zones[RLOPENXR_MAX_GPU_ZONES]; // In rlOpenXRGpuZoneBegin() order
+} RLOpenXRGpuTimings;
+
 typedef struct
 {
 	XrInstance instance; // the instance handle can be thought of as the basic connection to the OpenXR runtime
@@ -29,6 +98,86 @@ typedef struct
 	XrReferenceSpaceType play_space_type /*= XR_REFERENCE_SPACE_TYPE_STAGE*/;
 } RLOpenXRData;
 
+typedef enum
+{
+	RLOPENXR_EVENT_SESSION_STATE_CHANGED,          // session_state, previous_session_state
+	RLOPENXR_EVENT_VISIBILITY_CHANGED,             // visible, focused. Follows the session state, eg to pause the app when the headset is taken off
+	RLOPENXR_EVENT_INTERACTION_PROFILE_CHANGED,    // A controller was switched, see xrGetCurrentInteractionProfile()
+	RLOPENXR_EVENT_REFERENCE_SPACE_CHANGE_PENDING, // reference_space_type changes at time, eg a recenter. pose_valid, position and orientation are in the previous space
+	RLOPENXR_EVENT_INSTANCE_LOSS_PENDING,          // The runtime goes away at time, call rlOpenXRShutdown()
+	RLOPENXR_EVENT_EVENTS_LOST,                    // lost_event_count events were lost, by the runtime or because rlOpenXRPollEvent() fell behind
+	RLOPENXR_EVENT_TYPE_COUNT
+} RLOpenXREventType;
+
+// Runtime event, see rlOpenXRPollEvent(). Fields not used by the type are 0
+typedef struct
+{
+	RLOpenXREventType type;
+	XrTime time;
+
+	XrSessionState session_state;
+	XrSessionState previous_session_state;
+	bool visible;
+	bool focused;
+
+	XrReferenceSpaceType reference_space_type;
+	bool pose_valid;
+	Vector3 position;
+	Quaternion orientation;
+
+	uint32_t lost_event_count;
+} RLOpenXREvent;
+
+typedef void (*RLOpenXREventCallback)(const RLOpenXREvent* event, void* user_data);
+
+#define RLOPENXR_HAND_JOINT_COUNT 26 // XR_HAND_JOINT_COUNT_EXT, joints are indexed by XrHandJointEXT
+
+typedef struct
+{
+	Vector3 position;
+	Quaternion orientation;
+	float radius;
+} RLOpenXRHandJoint;
+
+// Articulated hand from XR_EXT_hand_tracking, see rlOpenXRGetHandJoints()
+typedef struct
+{
+	bool active; // The hand is tracked
+	RLOpenXRHandJoint joints[RLOPENXR_HAND_JOINT_COUNT]; // In the play space
+	XrSpaceLocationFlags location_flags[RLOPENXR_HAND_JOINT_COUNT];
+} RLOpenXRHandJoints;
+
+// Output of rlOpenXRLocateSpaces(), one array per component so results can be processed with SIMD.
+// Every array is allocated by the caller with at least `count` elements.
+typedef struct
+{
+	float* position_x;
+	float* position_y;
+	float* position_z;
+	float* orientation_x;
+	float* orientation_y;
+	float* orientation_z;
+	float* orientation_w;
+	XrSpaceLocationFlags* location_flags; // XR_SPACE_LOCATION_*_VALID_BIT / *_TRACKED_BIT, 0 when the space could not be located
+} RLOpenXRSpaceLocations;
+
+// State of an action registered with rlOpenXRCreateAction(), refreshed once per rlOpenXRUpdate()
+typedef struct
+{
+	bool active;   // Bound to an input, and its action set is active
+	bool changed;  // The value changed in the last sync
+	bool down;     // Boolean actions are down when true, float and vector2 actions when the value is above 0.5
+	bool pressed;  // Went down this frame
+	bool released; // Went up this frame
+	float value;   // Boolean actions are 0 or 1, vector2 actions hold the length of the vector
+	Vector2 vector2;
+
+	// Pose actions, located in the play space at rlOpenXRGetTime()
+	bool pose_valid;
+	Vector3 position;
+	Quaternion orientation;
+} RLOpenXRActionState;
+
 typedef struct
 {
 	// OpenXR Ouput Data
@@ -54,7 +203,15 @@ extern "C" {
 #endif
 
 // Setup
-bool rlOpenXRSetup();
+void rlOpenXRSetConfigFlags(unsigned int flags); // Same as raylib's SetConfigFlags(), call before rlOpenXRSetup()
+void rlOpenXRSetResolutionScaleRange(float min_scale, float max_scale); // Relative to the recommended resolution, default 0.5 - 1.0. The max is capped by the runtime. Call before rlOpenXRSetup()
+void rlOpenXRSetSwapchainColorFormats(const int64_t* formats, int count); // GL internal formats in order of preference, the first one the runtime supports is used. Default GL_SRGB8_ALPHA8. Call before rlOpenXRSetup()
+void rlOpenXRSetSwapchainDepthFormats(const int64_t* formats, int count); // Same for depth, default GL_DEPTH_COMPONENT16. Depth is disabled when none are supported. Stencil formats are attached as depth-stencil
+void rlOpenXRSetControllerModelCacheDir(const char* path); // Keep controller models on disk, so they load without the runtime next time. NULL disables it (default). Call before rlOpenXRSetup()
+void rlOpenXRSetLogLevel(RLOpenXRLogLevel level); // Levels above the compiled RLOPENXR_LOG_LEVEL are always dropped. Also filters the runtime's debug messages, set it before rlOpenXRSetup() for that
+void rlOpenXRSetLogToTraceLog(bool enabled); // Write log messages with raylib's TraceLog() instead of stdout / stderr. Messages are written from a background thread
+void rlOpenXRSetIdleSleep(int milliseconds); // Sleep in rlOpenXRUpdate() while there is no running session (headset off, IDLE or STOPPING), so the loop doesn't spin without xrWaitFrame(). Default 100, 0 disables it
+bool rlOpenXRSetup(); // false on failure, with everything it created released again. rlOpenXRShutdown() is then not needed
 void rlOpenXRShutdown();
 
 // Update
@@ -63,23 +220,95 @@ void rlOpenXRUpdate();
 void rlOpenXRUpdateCamera(Camera3D* camera);
 void rlOpenXRUpdateCameraTransform(Transform* transform);
 
+// Events
+bool rlOpenXRPollEvent(RLOpenXREvent* event); // Oldest event seen by rlOpenXRUpdate(), false when there is none. Can be called from another thread
+void rlOpenXRSetEventCallback(RLOpenXREventType type, RLOpenXREventCallback callback, void* user_data); // Called from rlOpenXRUpdate() instead of queueing events of the type. NULL to queue them again
+
 // Drawing
-bool rlOpenXRBegin();
+bool rlOpenXRBegin(); // false when there is nothing to render, eg. the runtime set XrFrameState::shouldRender to false. Call rlOpenXREnd() either way
 bool rlOpenXRBeginMockHMD();
 void rlOpenXREnd();
 
 void rlOpenXRBlitToWindow(RLOpenXREye eye, bool keep_aspect_ratio);
 
+// Same as raylib's DrawMesh() / DrawModel(), but materials with the default shader draw both eyes in one draw call.
+// With RLOPENXR_FLAG_MULTIVIEW through the multiview shader, otherwise as 2 instances in the side by side framebuffer.
+// Materials with a custom shader are passed to DrawMesh() as is, without multiview that draws the mesh once per eye.
+void rlOpenXRDrawMesh(Mesh mesh, Material material, Matrix transform);
+void rlOpenXRDrawModel(Model model, Vector3 position, float scale, Color tint);
+void rlOpenXRDrawModelEx(Model model, Vector3 position, Vector3 rotation_axis, float rotation_angle, Vector3 scale, Color tint);
+
+Shader rlOpenXRGetMultiviewShader(); // Replaces raylib's default shader with RLOPENXR_FLAG_MULTIVIEW, assign it to materials. id is 0 when multiview is not active.
+                                     // Undoes the projection of the camera passed to rlOpenXRUpdateCamera() (`uniform mat4 rlOpenXRProjectionInverse`), draw other projections with rlOpenXRDrawMesh()
+
+void rlOpenXRSetSpaceWarpActive(bool active); // Switch between half rate with SpaceWarp and native rate at runtime. Active by default with RLOPENXR_FLAG_SPACE_WARP
+bool rlOpenXRIsSpaceWarpActive();
+
+// Layers
+// Composited by the runtime on top of the eye buffers, every layer has its own swapchain. Their content is only redrawn when it is dirty,
+// and the compositor reprojects the last image every frame. Suited for UI, text stays sharper than when it's rendered into the eyes.
+// static_image layers are drawn exactly once (XR_SWAPCHAIN_CREATE_STATIC_IMAGE_BIT), for content that never changes.
+// Create functions return the layer index, -1 on failure or when the runtime lacks the layer type.
+// All layer types are blended with premultiplied alpha, rlOpenXRBeginLayer() sets a blend function that writes it. Keep raylib's BLEND_ALPHA while drawing layers.
+int rlOpenXRCreateQuadLayer(int width, int height, RLOpenXRLayerSpace space, bool static_image); // width x height pixels, placed 1m in front of the space origin
+void rlOpenXRSetQuadLayerPose(int layer, Vector3 position, Quaternion orientation, Vector2 size); // Center of the quad in its space, size in meters
+int rlOpenXRCreateCylinderLayer(int width, int height, RLOpenXRLayerSpace space, bool static_image); // XR_KHR_composition_layer_cylinder, a quarter cylinder with a 1m radius around the space origin
+void rlOpenXRSetCylinderLayer(int layer, Vector3 position, Quaternion orientation, float radius, float central_angle, float aspect_ratio); // Angles in radians
+int rlOpenXRCreateEquirectLayer(int width, int height, bool static_image); // XR_KHR_composition_layer_equirect2, a full 360 panorama at infinity in play space. Composited behind the eye buffers, clear them to BLANK where it should show
+void rlOpenXRSetEquirectLayer(int layer, Vector3 position, Quaternion orientation, float radius, float central_horizontal_angle, float upper_vertical_angle, float lower_vertical_angle); // Radius 0 is infinite, angles in radians
+void rlOpenXRSetLayerVisible(int layer, bool visible); // Layers are visible by default
+void rlOpenXRMarkLayerDirty(int layer); // The content changed, the next rlOpenXRBeginLayer() redraws it. New layers start dirty, static_image layers can't be marked again
+bool rlOpenXRBeginLayer(int layer); // Draw into the layer like BeginTextureMode(), outside of rlOpenXRBegin() / rlOpenXREnd(). false when the layer is not dirty
+void rlOpenXREndLayer();
+void rlOpenXRDestroyLayer(int layer);
+
 // State
 const RLOpenXRData* rlOpenXRData();
+void rlOpenXRGetSwapchainFormats(int64_t* color_format, int64_t* depth_format); // Negotiated GL internal formats, depth is 0 when depth is disabled. Either can be NULL
 
 // Input / Hands
 void rlOpenXRUpdateHands(RLHand* left, RLHand* right);
 
 void rlOpenXRSyncSingleActionSet(XrActionSet action_set); // Utility function for xrSyncAction with a single action set.
+bool rlOpenXRLocateSpaces(const XrSpace* spaces, int count, XrTime time, RLOpenXRSpaceLocations* locations); // Locates all spaces in the play space in one call (XR_KHR_locate_spaces when available). time 0 uses rlOpenXRGetTime()
+
+bool rlOpenXRIsHandTrackingSupported(); // XR_EXT_hand_tracking is available and the system tracks hands
+bool rlOpenXRGetHandJoints(RLOpenXRHandEnum hand, RLOpenXRHandJoints* joints); // Located at rlOpenXRGetTime(), false when the hand is not tracked
+void rlOpenXRGetHandJointMatrices(const RLOpenXRHandJoints* joints, Matrix* matrices); // RLOPENXR_HAND_JOINT_COUNT joint transforms, converted 4 at a time with SSE when available
+
+// Controller models (XR_MSFT_controller_model)
+// Models are loaded and decoded on a background thread when the interaction profile changes, and uploaded a piece per rlOpenXRUpdate().
+bool rlOpenXRIsControllerModelSupported();
+bool rlOpenXRGetControllerModel(RLOpenXRHandEnum hand, Model* model); // false until the model of the current controller is ready. Owned by rlOpenXR, valid until rlOpenXRShutdown()
+bool rlOpenXRDrawControllerModel(const RLHand* hand, Color tint); // Draws at the hand pose, which has to come from a grip pose action. false when nothing was drawn
+
+// Paths
+XrPath rlOpenXRPath(const char* path); // xrStringToPath(), but every string is only converted once per instance. XR_NULL_PATH on failure
+const char* rlOpenXRPathString(XrPath path); // Reverse of rlOpenXRPath(), NULL on failure. Valid until rlOpenXRShutdown()
+
+// Actions
+// Declarative alternative to creating action sets and actions by hand. All active sets are synced with one xrSyncActions() in rlOpenXRUpdate(),
+// and the state of every action is copied into memory there, so reading it does not call into the runtime.
+int rlOpenXRCreateActionSet(const char* name, const char* localized_name, unsigned int priority); // Returns the action set index, -1 on failure
+int rlOpenXRCreateAction(int action_set, const char* name, const char* localized_name, XrActionType type, bool per_hand); // per_hand actions have a state per hand. Returns the action index, -1 on failure
+bool rlOpenXRSuggestActionBinding(int action, const char* interaction_profile, const char* binding); // eg, "/interaction_profiles/khr/simple_controller", "/user/hand/left/input/select/click"
+bool rlOpenXRAttachActionSets(); // Submits the suggested bindings and attaches every set to the session. Call once, after all actions are created
+void rlOpenXRSetActionSetActive(int action_set, bool active); // Sets are active by default, inactive sets are not synced
+const RLOpenXRActionState* rlOpenXRGetActionState(int action, RLOpenXRHandEnum hand); // hand is ignored for actions that are not per_hand
+XrAction rlOpenXRGetAction(int action);
+void rlOpenXRSetHandPoseAction(RLHand* hand, int pose_action); // Use a per_hand pose action for rlOpenXRUpdateHands(), set hand->handedness first
+
+// Stats
+float rlOpenXRGetResolutionScale(); // Current resolution scale, always 1.0 without RLOPENXR_FLAG_DYNAMIC_RESOLUTION
+void rlOpenXRGpuZoneBegin(const char* name); // Time a section of GPU work, between rlOpenXRBegin() and rlOpenXREnd(). Can be nested
+void rlOpenXRGpuZoneEnd();
+void rlOpenXRGetGpuTimings(RLOpenXRGpuTimings* timings); // Results lag a few frames behind, reading them never stalls the GPU
+void rlOpenXRGetFrameStats(RLOpenXRFrameStats* stats); // Rolling window over the last 300 frames
+void rlOpenXRSetFrameStatsDumpPath(const char* path); // Write the window at rlOpenXRShutdown(), as JSON if path ends with ".json", CSV otherwise. NULL to disable
 
 // Misc
-XrTime rlOpenXRGetTime();
+XrTime rlOpenXRGetTime(); // Frozen per frame: sampled on the first call after a new frame state (rlOpenXRUpdate(), or rlOpenXRBegin() with RLOPENXR_FLAG_PIPELINED_WAIT_FRAME),
+                          // then returned unchanged, so every pose of a frame is located at the same time. Not a clock, use raylib's GetTime() to measure time
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,2322 @@
+// rlOpenXR Mock Runtime
+// A minimal OpenXR runtime implementing the subset of the API that rlOpenXR uses.
+// It is loaded through the regular loader with XR_RUNTIME_JSON=<build>/rlOpenXR_mock_runtime.json,
+// so the rlOpenXR frame loop can be exercised and timed on machines without a headset.
+//
+// Configuration is read from environment variables when the instance is created:
+//   RLOPENXR_MOCK_DISPLAY_PERIOD_NS   Display period in nanoseconds (default 11111111, 90Hz)
+//   RLOPENXR_MOCK_JITTER_NS           Max deterministic jitter added to each predicted display time (default 0)
+//   RLOPENXR_MOCK_SEED                Seed for the jitter sequence (default 1)
+//   RLOPENXR_MOCK_REALTIME            1: xrWaitFrame sleeps to pace frames, 0: never sleeps, fully deterministic (default 1)
+//   RLOPENXR_MOCK_VIEW_WIDTH/HEIGHT   Recommended per eye resolution (default 1024x1024), max is twice that
+//   RLOPENXR_MOCK_EXIT_AFTER_FRAMES   Request session exit after this many ended frames (default 0, never)
+//   RLOPENXR_MOCK_POSE_SCRIPT         Path to a pose script, lines of: <seconds> <user path> px py pz qx qy qz qw
+//                                     eg: "0.5 /user/head 0 1.6 0 0 0 0 1". Keyframes are interpolated per path.
+
+#define XR_USE_GRAPHICS_API_OPENGL
+#define XR_USE_TIMESPEC
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <time.h>
+#include "openxr/openxr.h"
+#include "openxr/openxr_platform.h"
+#include "openxr/openxr_reflection.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+static_assert(sizeof(void*) == 8, "The mock runtime uses object pointers as handles, which requires 64 bit handles.");
+
+#if defined(_WIN32)
+#define RLOPENXR_MOCK_EXPORT __declspec(dllexport)
+#else
+#define RLOPENXR_MOCK_EXPORT __attribute__((visibility("default")))
+#endif
+
+
+// Loader negotiation
+// Mirrors loader_interfaces.h from the OpenXR-SDK, which is not part of the public headers in the SDK version we fetch.
+// ============================================================================
+
+namespace loader
+{
+	enum XrLoaderInterfaceStructs
+	{
+		XR_LOADER_INTERFACE_STRUCT_UNINTIALIZED = 0,
+		XR_LOADER_INTERFACE_STRUCT_LOADER_INFO,
+		XR_LOADER_INTERFACE_STRUCT_API_LAYER_REQUEST,
+		XR_LOADER_INTERFACE_STRUCT_RUNTIME_REQUEST,
+		XR_LOADER_INTERFACE_STRUCT_API_LAYER_CREATE_INFO,
+		XR_LOADER_INTERFACE_STRUCT_API_LAYER_NEXT_INFO,
+	};
+
+	constexpr uint32_t XR_LOADER_INFO_STRUCT_VERSION = 1;
+	constexpr uint32_t XR_RUNTIME_INFO_STRUCT_VERSION = 1;
+	constexpr uint32_t XR_CURRENT_LOADER_RUNTIME_VERSION = 1;
+
+	struct XrNegotiateLoaderInfo
+	{
+		XrLoaderInterfaceStructs structType;
+		uint32_t structVersion;
+		size_t structSize;
+		uint32_t minInterfaceVersion;
+		uint32_t maxInterfaceVersion;
+		XrVersion minApiVersion;
+		XrVersion maxApiVersion;
+	};
+
+	struct XrNegotiateRuntimeRequest
+	{
+		XrLoaderInterfaceStructs structType;
+		uint32_t structVersion;
+		size_t structSize;
+		uint32_t runtimeInterfaceVersion;
+		XrVersion runtimeApiVersion;
+		PFN_xrGetInstanceProcAddr getInstanceProcAddr;
+	};
+}
+
+
+// Types
+// ============================================================================
+
+struct MockConfig
+{
+	XrDuration display_period = 11'111'111;
+	XrDuration jitter = 0;
+	uint64_t seed = 1;
+	bool realtime = true;
+	uint32_t view_width = 1024;
+	uint32_t view_height = 1024;
+	uint64_t exit_after_frames = 0;
+	std::string pose_script;
+};
+
+struct PoseKeyframe
+{
+	double time;
+	XrPosef pose;
+};
+
+struct MockInstance;
+struct MockSession;
+
+struct MockActionSet
+{
+	MockInstance* instance = nullptr;
+	std::string name;
+	bool attached = false;
+};
+
+struct MockAction
+{
+	MockActionSet* action_set = nullptr;
+	std::string name;
+	XrActionType type = XR_ACTION_TYPE_BOOLEAN_INPUT;
+	std::vector<XrPath> subaction_paths;
+};
+
+struct MockSpace
+{
+	MockSession* session = nullptr;
+	bool is_action_space = false;
+	XrReferenceSpaceType reference_type = XR_REFERENCE_SPACE_TYPE_STAGE;
+	MockAction* action = nullptr;
+	XrPath subaction_path = XR_NULL_PATH;
+	XrPosef offset{};
+};
+
+struct MockSwapchain
+{
+	MockSession* session = nullptr;
+	XrSwapchainCreateInfo info{};
+	std::vector<uint32_t> images;
+	uint32_t next_image = 0;
+	std::deque<uint32_t> acquired; // Acquired, in order
+	uint32_t waited_count = 0;     // Number of images at the front of `acquired` that are waited on
+	uint32_t acquire_count = 0;    // Total acquires, STATIC_IMAGE swapchains can only be acquired once
+	bool has_released_image = false;
+};
+
+struct MockSession
+{
+	MockInstance* instance = nullptr;
+	XrSessionState state = XR_SESSION_STATE_UNKNOWN;
+	bool running = false;
+	bool exit_requested = false;
+
+	XrTime epoch = 0;          // Time the session started, poses and display times are relative to this
+	int64_t frame_index = -1;  // Index of the last waited frame
+	uint64_t frames_waited = 0;
+	uint64_t frames_begun = 0;
+	uint64_t frames_ended = 0;
+	bool frame_in_progress = false;
+	XrTime waited_display_time = 0;
+	XrTime begun_display_time = 0;
+
+	std::vector<MockSpace*> spaces;
+	std::vector<MockSwapchain*> swapchains;
+};
+
+struct MockMessenger
+{
+	MockInstance* instance = nullptr;
+	XrDebugUtilsMessageSeverityFlagsEXT severities = 0;
+	PFN_xrDebugUtilsMessengerCallbackEXT callback = nullptr;
+	void* user_data = nullptr;
+};
+
+struct MockInstance
+{
+	std::vector<std::string> enabled_extensions;
+	bool graphics_requirements_queried = false;
+
+	std::vector<std::string> paths; // XrPath N is paths[N - 1]
+	std::unordered_map<std::string, XrPath> path_lookup;
+
+	std::unordered_map<std::string, std::vector<PoseKeyframe>> pose_tracks;
+	std::deque<XrEventDataBuffer> events;
+
+	std::vector<MockSession*> sessions;
+	std::vector<MockActionSet*> action_sets;
+	std::vector<MockAction*> actions;
+	std::vector<MockMessenger*> messengers;
+	XrPath suggested_profile = XR_NULL_PATH;
+};
+
+struct MockRuntime
+{
+	std::mutex mutex;
+	std::condition_variable frame_cv;
+
+	MockConfig config;
+	MockInstance* instance = nullptr;
+
+	// Live handles, to detect invalid or destroyed handles
+	std::unordered_set<const void*> handles;
+};
+
+static MockRuntime g_mock;
+
+
+// Constants
+// ============================================================================
+
+constexpr XrSystemId c_system_id = 1;
+constexpr uint32_t c_view_count = 2;
+constexpr uint32_t c_swapchain_image_count = 3;
+constexpr uint32_t c_max_layer_count = 16;
+constexpr float c_ipd = 0.063f;
+
+constexpr const char* c_supported_extensions[] = {
+	XR_KHR_OPENGL_ENABLE_EXTENSION_NAME,
+	XR_MNDX_EGL_ENABLE_EXTENSION_NAME,
+	XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME,
+	XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME,
+	XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME,
+	XR_KHR_COMPOSITION_LAYER_EQUIRECT2_EXTENSION_NAME,
+	XR_FB_SPACE_WARP_EXTENSION_NAME,
+	XR_EXT_DEBUG_UTILS_EXTENSION_NAME,
+};
+
+constexpr int64_t c_swapchain_formats[] = {
+	// Color, in order of preference
+	GL_SRGB8_ALPHA8,
+	GL_RGBA8,
+	GL_RGB10_A2,
+	GL_R11F_G11F_B10F,
+	GL_RGBA16F,
+	// Depth
+	GL_DEPTH_COMPONENT16,
+	GL_DEPTH_COMPONENT24,
+	GL_DEPTH_COMPONENT32F,
+	GL_DEPTH24_STENCIL8,
+};
+
+
+// Helpers
+// ============================================================================
+
+template<typename Handle, typename T>
+static Handle to_handle(T* object)
+{
+	g_mock.handles.insert(object);
+	return reinterpret_cast<Handle>(object);
+}
+
+template<typename T, typename Handle>
+static T* from_handle(Handle handle)
+{
+	auto* object = reinterpret_cast<T*>(handle);
+	if (object == nullptr || g_mock.handles.count(object) == 0)
+	{
+		return nullptr;
+	}
+	return object;
+}
+
+template<typename T>
+static void destroy_handle(T* object)
+{
+	g_mock.handles.erase(object);
+	delete object;
+}
+
+static XrTime now_xr_time()
+{
+	timespec ts{};
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (XrTime)ts.tv_sec * 1'000'000'000 + ts.tv_nsec;
+}
+
+static void sleep_until_xr_time(XrTime time)
+{
+	timespec ts{};
+	ts.tv_sec = time / 1'000'000'000;
+	ts.tv_nsec = time % 1'000'000'000;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+}
+
+static bool extension_enabled(const MockInstance* instance, const char* name)
+{
+	return std::find(instance->enabled_extensions.begin(), instance->enabled_extensions.end(), name) != instance->enabled_extensions.end();
+}
+
+// A report waiting to be delivered to a debug messenger
+struct PendingReport
+{
+	PFN_xrDebugUtilsMessengerCallbackEXT callback = nullptr;
+	void* user_data = nullptr;
+	XrDebugUtilsMessageSeverityFlagsEXT severity = 0;
+	std::string message;
+};
+
+static thread_local std::vector<PendingReport> t_pending_reports;
+
+// Reports to stderr and every debug messenger, so rlOpenXR sees it in its own log.
+// Called with g_mock.mutex held, the messengers are only invoked once MockLock releases it.
+static void report(XrDebugUtilsMessageSeverityFlagsEXT severity, const char* format, ...)
+{
+	char message[1024];
+	va_list args;
+	va_start(args, format);
+	vsnprintf(message, sizeof(message), format, args);
+	va_end(args);
+
+	fprintf(stderr, "[rlOpenXR mock runtime] %s\n", message);
+
+	if (g_mock.instance == nullptr)
+	{
+		return;
+	}
+
+	for (MockMessenger* messenger : g_mock.instance->messengers)
+	{
+		if ((messenger->severities & severity) != 0 && messenger->callback != nullptr)
+		{
+			t_pending_reports.push_back(PendingReport{ messenger->callback, messenger->user_data, severity, message });
+		}
+	}
+}
+
+static void deliver_reports()
+{
+	std::vector<PendingReport> reports;
+	reports.swap(t_pending_reports);
+
+	for (const PendingReport& pending : reports)
+	{
+		XrDebugUtilsMessengerCallbackDataEXT callback_data{ XR_TYPE_DEBUG_UTILS_MESSENGER_CALLBACK_DATA_EXT };
+		callback_data.messageId = "rlOpenXR-mock";
+		callback_data.functionName = "";
+		callback_data.message = pending.message.c_str();
+
+		pending.callback(pending.severity, XR_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT, &callback_data, pending.user_data);
+	}
+}
+
+// Holds g_mock.mutex for an entry point. The messenger callbacks run application code that may call back into
+// the runtime, so reports made under the lock are delivered after it is released.
+struct MockLock
+{
+	std::unique_lock<std::mutex> lock{ g_mock.mutex };
+
+	~MockLock()
+	{
+		unlock();
+	}
+
+	void unlock()
+	{
+		if (lock.owns_lock())
+		{
+			lock.unlock();
+		}
+		deliver_reports();
+	}
+};
+
+#define MOCK_VALIDATION_ERROR(...) (report(XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, __VA_ARGS__), XR_ERROR_VALIDATION_FAILURE)
+
+static uint64_t env_u64(const char* name, uint64_t fallback)
+{
+	const char* value = getenv(name);
+	return (value != nullptr && value[0] != '\0') ? strtoull(value, nullptr, 10) : fallback;
+}
+
+static MockConfig load_config()
+{
+	MockConfig config;
+	config.display_period = (XrDuration)env_u64("RLOPENXR_MOCK_DISPLAY_PERIOD_NS", (uint64_t)config.display_period);
+	config.jitter = (XrDuration)env_u64("RLOPENXR_MOCK_JITTER_NS", (uint64_t)config.jitter);
+	config.seed = env_u64("RLOPENXR_MOCK_SEED", config.seed);
+	config.realtime = env_u64("RLOPENXR_MOCK_REALTIME", 1) != 0;
+	config.view_width = (uint32_t)env_u64("RLOPENXR_MOCK_VIEW_WIDTH", config.view_width);
+	config.view_height = (uint32_t)env_u64("RLOPENXR_MOCK_VIEW_HEIGHT", config.view_height);
+	config.exit_after_frames = env_u64("RLOPENXR_MOCK_EXIT_AFTER_FRAMES", config.exit_after_frames);
+
+	if (const char* script = getenv("RLOPENXR_MOCK_POSE_SCRIPT"))
+	{
+		config.pose_script = script;
+	}
+
+	// Display times have to stay monotonic
+	config.display_period = std::max<XrDuration>(config.display_period, 1'000'000);
+	config.jitter = std::min<XrDuration>(config.jitter, config.display_period / 2 - 1);
+
+	return config;
+}
+
+static void load_pose_script(MockInstance* instance, const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		report(XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT, "Could not open pose script '%s', using the default poses", path.c_str());
+		return;
+	}
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream stream(line);
+		PoseKeyframe key{};
+		std::string user_path;
+		auto& p = key.pose.position;
+		auto& q = key.pose.orientation;
+		if (stream >> key.time >> user_path >> p.x >> p.y >> p.z >> q.x >> q.y >> q.z >> q.w)
+		{
+			instance->pose_tracks[user_path].push_back(key);
+		}
+	}
+
+	for (auto& [user_path, keys] : instance->pose_tracks)
+	{
+		std::stable_sort(keys.begin(), keys.end(), [](const PoseKeyframe& a, const PoseKeyframe& b) { return a.time < b.time; });
+	}
+}
+
+// Pose math
+static XrQuaternionf quat_multiply(const XrQuaternionf& a, const XrQuaternionf& b)
+{
+	return XrQuaternionf{
+		a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+		a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+	};
+}
+
+static XrVector3f quat_rotate(const XrQuaternionf& q, const XrVector3f& v)
+{
+	const XrQuaternionf p{ v.x, v.y, v.z, 0 };
+	const XrQuaternionf q_conjugate{ -q.x, -q.y, -q.z, q.w };
+	const XrQuaternionf r = quat_multiply(quat_multiply(q, p), q_conjugate);
+	return XrVector3f{ r.x, r.y, r.z };
+}
+
+static XrQuaternionf quat_normalize(const XrQuaternionf& q)
+{
+	const float length = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+	if (length <= 0.f)
+	{
+		return XrQuaternionf{ 0, 0, 0, 1 };
+	}
+	return XrQuaternionf{ q.x / length, q.y / length, q.z / length, q.w / length };
+}
+
+// Returns `child` (relative to `parent`) in the space `parent` is relative to
+static XrPosef pose_multiply(const XrPosef& parent, const XrPosef& child)
+{
+	const XrVector3f rotated = quat_rotate(parent.orientation, child.position);
+	return XrPosef{
+		quat_multiply(parent.orientation, child.orientation),
+		XrVector3f{ parent.position.x + rotated.x, parent.position.y + rotated.y, parent.position.z + rotated.z }
+	};
+}
+
+static XrPosef pose_inverse(const XrPosef& pose)
+{
+	const XrQuaternionf inverse_orientation{ -pose.orientation.x, -pose.orientation.y, -pose.orientation.z, pose.orientation.w };
+	const XrVector3f position = quat_rotate(inverse_orientation, pose.position);
+	return XrPosef{ inverse_orientation, XrVector3f{ -position.x, -position.y, -position.z } };
+}
+
+static XrPosef pose_interpolate(const XrPosef& a, const XrPosef& b, float t)
+{
+	// nlerp, along the shortest arc
+	const float dot = a.orientation.x * b.orientation.x + a.orientation.y * b.orientation.y + a.orientation.z * b.orientation.z + a.orientation.w * b.orientation.w;
+	const float sign = dot < 0.f ? -1.f : 1.f;
+
+	XrPosef result;
+	result.orientation = quat_normalize(XrQuaternionf{
+		a.orientation.x + (sign * b.orientation.x - a.orientation.x) * t,
+		a.orientation.y + (sign * b.orientation.y - a.orientation.y) * t,
+		a.orientation.z + (sign * b.orientation.z - a.orientation.z) * t,
+		a.orientation.w + (sign * b.orientation.w - a.orientation.w) * t });
+	result.position = XrVector3f{
+		a.position.x + (b.position.x - a.position.x) * t,
+		a.position.y + (b.position.y - a.position.y) * t,
+		a.position.z + (b.position.z - a.position.z) * t };
+	return result;
+}
+
+static XrPosef default_user_pose(const std::string& user_path, double seconds)
+{
+	// Slow deterministic sway so views actually change every frame
+	const float yaw = 0.2f * (float)sin(seconds * 0.5 * 3.14159265358979);
+	const XrQuaternionf orientation{ 0, sinf(yaw * 0.5f), 0, cosf(yaw * 0.5f) };
+
+	if (user_path == "/user/hand/left")
+	{
+		return XrPosef{ orientation, XrVector3f{ -0.2f, 1.3f, -0.3f } };
+	}
+	if (user_path == "/user/hand/right")
+	{
+		return XrPosef{ orientation, XrVector3f{ 0.2f, 1.3f, -0.3f } };
+	}
+	return XrPosef{ orientation, XrVector3f{ 0.f, 1.6f, 0.f } };
+}
+
+static XrPosef user_pose(const MockSession* session, const std::string& user_path, XrTime time)
+{
+	const double seconds = (double)(time - session->epoch) * 1e-9;
+
+	auto track = session->instance->pose_tracks.find(user_path);
+	if (track == session->instance->pose_tracks.end() || track->second.empty())
+	{
+		return default_user_pose(user_path, seconds);
+	}
+
+	const auto& keys = track->second;
+	if (seconds <= keys.front().time)
+	{
+		return keys.front().pose;
+	}
+	if (seconds >= keys.back().time)
+	{
+		return keys.back().pose;
+	}
+
+	auto next = std::upper_bound(keys.begin(), keys.end(), seconds, [](double t, const PoseKeyframe& key) { return t < key.time; });
+	auto previous = next - 1;
+	const float t = (float)((seconds - previous->time) / (next->time - previous->time));
+	return pose_interpolate(previous->pose, next->pose, t);
+}
+
+static const std::string& path_string(const MockInstance* instance, XrPath path)
+{
+	static const std::string empty;
+	if (path == XR_NULL_PATH || path > instance->paths.size())
+	{
+		return empty;
+	}
+	return instance->paths[path - 1];
+}
+
+static XrPosef space_pose(const MockSpace* space, XrTime time)
+{
+	const MockSession* session = space->session;
+
+	if (space->is_action_space)
+	{
+		XrPath subaction_path = space->subaction_path;
+		if (subaction_path == XR_NULL_PATH && !space->action->subaction_paths.empty())
+		{
+			subaction_path = space->action->subaction_paths[0];
+		}
+		return pose_multiply(user_pose(session, path_string(session->instance, subaction_path), time), space->offset);
+	}
+
+	if (space->reference_type == XR_REFERENCE_SPACE_TYPE_VIEW)
+	{
+		return pose_multiply(user_pose(session, "/user/head", time), space->offset);
+	}
+
+	// STAGE and LOCAL share the same origin in the mock runtime
+	return space->offset;
+}
+
+static XrPosef eye_pose(const MockSession* session, uint32_t eye, XrTime time)
+{
+	const XrPosef eye_offset{ XrQuaternionf{ 0, 0, 0, 1 }, XrVector3f{ eye == 0 ? -c_ipd * 0.5f : c_ipd * 0.5f, 0, 0 } };
+	return pose_multiply(user_pose(session, "/user/head", time), eye_offset);
+}
+
+static XrFovf eye_fov(uint32_t eye)
+{
+	// Slightly asymmetric, like most real HMDs
+	const float inner = 0.75f;
+	const float outer = 0.82f;
+	return eye == 0 ? XrFovf{ -outer, inner, 0.80f, -0.85f } : XrFovf{ -inner, outer, 0.80f, -0.85f };
+}
+
+static uint64_t splitmix64(uint64_t x)
+{
+	x += 0x9E3779B97F4A7C15ull;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+	return x ^ (x >> 31);
+}
+
+// Deterministic for a given frame index, regardless of how many frames were skipped before it
+static XrTime predicted_display_time(const MockSession* session, int64_t frame_index)
+{
+	const MockConfig& config = g_mock.config;
+
+	XrDuration jitter = 0;
+	if (config.jitter > 0)
+	{
+		const uint64_t random = splitmix64(config.seed ^ (uint64_t)frame_index);
+		jitter = (XrDuration)(random % (uint64_t)(2 * config.jitter + 1)) - config.jitter;
+	}
+
+	return session->epoch + (frame_index + 1) * config.display_period + jitter;
+}
+
+static void push_event(MockInstance* instance, const void* event, size_t size)
+{
+	XrEventDataBuffer buffer{};
+	memcpy(&buffer, event, std::min(size, sizeof(buffer)));
+	instance->events.push_back(buffer);
+}
+
+static void push_session_state(MockSession* session, XrSessionState state)
+{
+	session->state = state;
+
+	XrEventDataSessionStateChanged event{ XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED };
+	event.session = reinterpret_cast<XrSession>(session);
+	event.state = state;
+	event.time = now_xr_time();
+	push_event(session->instance, &event, sizeof(event));
+}
+
+static bool is_depth_format(int64_t format)
+{
+	return format == GL_DEPTH_COMPONENT16 || format == GL_DEPTH_COMPONENT24 || format == GL_DEPTH_COMPONENT32F || format == GL_DEPTH24_STENCIL8;
+}
+
+static void gl_upload_format(int64_t internal_format, GLenum* format, GLenum* type)
+{
+	switch (internal_format)
+	{
+	case GL_DEPTH24_STENCIL8: *format = GL_DEPTH_STENCIL; *type = GL_UNSIGNED_INT_24_8; break;
+	case GL_DEPTH_COMPONENT16:
+	case GL_DEPTH_COMPONENT24:
+	case GL_DEPTH_COMPONENT32F: *format = GL_DEPTH_COMPONENT; *type = GL_FLOAT; break;
+	case GL_R11F_G11F_B10F: *format = GL_RGB; *type = GL_FLOAT; break;
+	case GL_RGBA16F: *format = GL_RGBA; *type = GL_FLOAT; break;
+	default: *format = GL_RGBA; *type = GL_UNSIGNED_BYTE; break;
+	}
+}
+
+static XrResult validate_sub_image(const XrSwapchainSubImage& sub_image, const char* what)
+{
+	MockSwapchain* swapchain = from_handle<MockSwapchain>(sub_image.swapchain);
+	if (swapchain == nullptr)
+	{
+		return MOCK_VALIDATION_ERROR("%s: invalid swapchain handle", what);
+	}
+	if (!swapchain->has_released_image)
+	{
+		return MOCK_VALIDATION_ERROR("%s: swapchain has no released image", what);
+	}
+
+	const XrRect2Di& rect = sub_image.imageRect;
+	if (rect.offset.x < 0 || rect.offset.y < 0 || rect.extent.width <= 0 || rect.extent.height <= 0 ||
+		(uint32_t)(rect.offset.x + rect.extent.width) > swapchain->info.width ||
+		(uint32_t)(rect.offset.y + rect.extent.height) > swapchain->info.height)
+	{
+		return MOCK_VALIDATION_ERROR("%s: imageRect {%d, %d, %d, %d} is outside of the %ux%u swapchain", what,
+			rect.offset.x, rect.offset.y, rect.extent.width, rect.extent.height, swapchain->info.width, swapchain->info.height);
+	}
+	if (sub_image.imageArrayIndex >= swapchain->info.arraySize)
+	{
+		return MOCK_VALIDATION_ERROR("%s: imageArrayIndex %u is outside of arraySize %u", what, sub_image.imageArrayIndex, swapchain->info.arraySize);
+	}
+
+	return XR_SUCCESS;
+}
+
+static XrResult validate_space_warp_info(const MockInstance* instance, const XrCompositionLayerSpaceWarpInfoFB* info)
+{
+	if (!extension_enabled(instance, XR_FB_SPACE_WARP_EXTENSION_NAME))
+	{
+		return MOCK_VALIDATION_ERROR("Space warp info: XR_FB_space_warp is not enabled");
+	}
+
+	XrResult result = validate_sub_image(info->motionVectorSubImage, "Space warp motion vectors");
+	if (XR_FAILED(result))
+	{
+		return result;
+	}
+	result = validate_sub_image(info->depthSubImage, "Space warp depth");
+	if (XR_FAILED(result))
+	{
+		return result;
+	}
+
+	const MockSwapchain* motion_vectors = from_handle<MockSwapchain>(info->motionVectorSubImage.swapchain);
+	const MockSwapchain* depth = from_handle<MockSwapchain>(info->depthSubImage.swapchain);
+	if (motion_vectors->info.format != GL_RGBA16F)
+	{
+		return MOCK_VALIDATION_ERROR("Space warp info: motion vector swapchain format 0x%llx is not GL_RGBA16F", (unsigned long long)motion_vectors->info.format);
+	}
+	if (!is_depth_format(depth->info.format))
+	{
+		return MOCK_VALIDATION_ERROR("Space warp info: depth swapchain format 0x%llx is not a depth format", (unsigned long long)depth->info.format);
+	}
+
+	const XrExtent2Di& motion_extent = info->motionVectorSubImage.imageRect.extent;
+	const XrExtent2Di& depth_extent = info->depthSubImage.imageRect.extent;
+	if (motion_extent.width != depth_extent.width || motion_extent.height != depth_extent.height)
+	{
+		return MOCK_VALIDATION_ERROR("Space warp info: motion vector rect %dx%d and depth rect %dx%d differ",
+			motion_extent.width, motion_extent.height, depth_extent.width, depth_extent.height);
+	}
+	if (info->minDepth < 0.f || info->maxDepth > 1.f || info->minDepth >= info->maxDepth)
+	{
+		return MOCK_VALIDATION_ERROR("Space warp info: invalid depth range [%f, %f]", info->minDepth, info->maxDepth);
+	}
+	if (info->nearZ == info->farZ)
+	{
+		return MOCK_VALIDATION_ERROR("Space warp info: nearZ and farZ are both %f", info->nearZ);
+	}
+
+	const XrQuaternionf& q = info->appSpaceDeltaPose.orientation;
+	if (fabsf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w - 1.f) > 0.01f)
+	{
+		return MOCK_VALIDATION_ERROR("Space warp info: appSpaceDeltaPose orientation is not normalized");
+	}
+
+	return XR_SUCCESS;
+}
+
+static XrResult validate_projection_layer(const MockInstance* instance, const XrCompositionLayerProjection* layer)
+{
+	if (from_handle<MockSpace>(layer->space) == nullptr)
+	{
+		return MOCK_VALIDATION_ERROR("Projection layer: invalid space");
+	}
+	if (layer->viewCount != c_view_count || layer->views == nullptr)
+	{
+		return MOCK_VALIDATION_ERROR("Projection layer: expected %u views, got %u", c_view_count, layer->viewCount);
+	}
+
+	for (uint32_t i = 0; i < layer->viewCount; ++i)
+	{
+		const XrCompositionLayerProjectionView& view = layer->views[i];
+		if (view.type != XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW)
+		{
+			return MOCK_VALIDATION_ERROR("Projection view %u: wrong structure type %d", i, view.type);
+		}
+
+		XrResult result = validate_sub_image(view.subImage, "Projection view");
+		if (XR_FAILED(result))
+		{
+			return result;
+		}
+
+		for (auto* next = (const XrBaseInStructure*)view.next; next != nullptr; next = next->next)
+		{
+			if (next->type == XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR)
+			{
+				const auto* depth_info = (const XrCompositionLayerDepthInfoKHR*)next;
+				result = validate_sub_image(depth_info->subImage, "Depth info");
+				if (XR_FAILED(result))
+				{
+					return result;
+				}
+				if (depth_info->minDepth < 0.f || depth_info->maxDepth > 1.f || depth_info->minDepth >= depth_info->maxDepth)
+				{
+					return MOCK_VALIDATION_ERROR("Depth info: invalid depth range [%f, %f]", depth_info->minDepth, depth_info->maxDepth);
+				}
+			}
+			else if (next->type == XR_TYPE_COMPOSITION_LAYER_SPACE_WARP_INFO_FB)
+			{
+				result = validate_space_warp_info(instance, (const XrCompositionLayerSpaceWarpInfoFB*)next);
+				if (XR_FAILED(result))
+				{
+					return result;
+				}
+			}
+		}
+	}
+
+	return XR_SUCCESS;
+}
+
+static XrResult validate_cylinder_layer(const XrCompositionLayerCylinderKHR* layer)
+{
+	if (from_handle<MockSpace>(layer->space) == nullptr)
+	{
+		return MOCK_VALIDATION_ERROR("Cylinder layer: invalid space");
+	}
+	if (!(layer->radius >= 0.f))
+	{
+		return MOCK_VALIDATION_ERROR("Cylinder layer: negative radius %f", layer->radius);
+	}
+	if (!(layer->centralAngle >= 0.f && layer->centralAngle <= 2.f * (float)M_PI))
+	{
+		return MOCK_VALIDATION_ERROR("Cylinder layer: centralAngle %f is outside of [0, 2pi]", layer->centralAngle);
+	}
+	if (!(layer->aspectRatio > 0.f))
+	{
+		return MOCK_VALIDATION_ERROR("Cylinder layer: aspectRatio %f is not positive", layer->aspectRatio);
+	}
+
+	return validate_sub_image(layer->subImage, "Cylinder layer");
+}
+
+static XrResult validate_equirect2_layer(const XrCompositionLayerEquirect2KHR* layer)
+{
+	if (from_handle<MockSpace>(layer->space) == nullptr)
+	{
+		return MOCK_VALIDATION_ERROR("Equirect2 layer: invalid space");
+	}
+	if (!(layer->radius >= 0.f))
+	{
+		return MOCK_VALIDATION_ERROR("Equirect2 layer: negative radius %f", layer->radius);
+	}
+	if (!(layer->centralHorizontalAngle >= 0.f && layer->centralHorizontalAngle <= 2.f * (float)M_PI))
+	{
+		return MOCK_VALIDATION_ERROR("Equirect2 layer: centralHorizontalAngle %f is outside of [0, 2pi]", layer->centralHorizontalAngle);
+	}
+	if (!(layer->lowerVerticalAngle >= -(float)M_PI_2 && layer->upperVerticalAngle <= (float)M_PI_2 && layer->lowerVerticalAngle <= layer->upperVerticalAngle))
+	{
+		return MOCK_VALIDATION_ERROR("Equirect2 layer: vertical angles [%f, %f] are outside of [-pi/2, pi/2]", layer->lowerVerticalAngle, layer->upperVerticalAngle);
+	}
+
+	return validate_sub_image(layer->subImage, "Equirect2 layer");
+}
+
+static XrResult validate_layer(const MockInstance* instance, const XrCompositionLayerBaseHeader* layer)
+{
+	if (layer == nullptr)
+	{
+		return MOCK_VALIDATION_ERROR("xrEndFrame: layer is NULL");
+	}
+
+	switch (layer->type)
+	{
+	case XR_TYPE_COMPOSITION_LAYER_PROJECTION:
+		return validate_projection_layer(instance, (const XrCompositionLayerProjection*)layer);
+	case XR_TYPE_COMPOSITION_LAYER_QUAD:
+	{
+		const auto* quad = (const XrCompositionLayerQuad*)layer;
+		if (from_handle<MockSpace>(quad->space) == nullptr)
+		{
+			return MOCK_VALIDATION_ERROR("Quad layer: invalid space");
+		}
+		return validate_sub_image(quad->subImage, "Quad layer");
+	}
+	case XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR:
+		if (!extension_enabled(instance, XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME))
+		{
+			return MOCK_VALIDATION_ERROR("xrEndFrame: cylinder layer without XR_KHR_composition_layer_cylinder enabled");
+		}
+		return validate_cylinder_layer((const XrCompositionLayerCylinderKHR*)layer);
+	case XR_TYPE_COMPOSITION_LAYER_EQUIRECT2_KHR:
+		if (!extension_enabled(instance, XR_KHR_COMPOSITION_LAYER_EQUIRECT2_EXTENSION_NAME))
+		{
+			return MOCK_VALIDATION_ERROR("xrEndFrame: equirect2 layer without XR_KHR_composition_layer_equirect2 enabled");
+		}
+		return validate_equirect2_layer((const XrCompositionLayerEquirect2KHR*)layer);
+	default:
+		report(XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrEndFrame: unsupported layer type %d", layer->type);
+		return XR_ERROR_LAYER_INVALID;
+	}
+}
+
+
+// OpenXR API
+// ============================================================================
+
+template<typename T>
+static XrResult two_call(uint32_t capacity, uint32_t* count_output, T* output, const T* source, uint32_t source_count)
+{
+	if (count_output == nullptr)
+	{
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+	*count_output = source_count;
+	if (capacity == 0)
+	{
+		return XR_SUCCESS;
+	}
+	if (capacity < source_count)
+	{
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	}
+	std::copy(source, source + source_count, output);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateApiLayerProperties(uint32_t /*capacity*/, uint32_t* count_output, XrApiLayerProperties* /*properties*/)
+{
+	*count_output = 0;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateInstanceExtensionProperties(const char* layer_name, uint32_t capacity, uint32_t* count_output, XrExtensionProperties* properties)
+{
+	if (layer_name != nullptr)
+	{
+		return XR_ERROR_API_LAYER_NOT_PRESENT;
+	}
+
+	constexpr uint32_t count = (uint32_t)std::size(c_supported_extensions);
+	*count_output = count;
+	if (capacity == 0)
+	{
+		return XR_SUCCESS;
+	}
+	if (capacity < count)
+	{
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		snprintf(properties[i].extensionName, XR_MAX_EXTENSION_NAME_SIZE, "%s", c_supported_extensions[i]);
+		properties[i].extensionVersion = 1;
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateInstance(const XrInstanceCreateInfo* create_info, XrInstance* instance)
+{
+	MockLock lock;
+
+	if (g_mock.instance != nullptr)
+	{
+		return XR_ERROR_LIMIT_REACHED;
+	}
+	if (XR_VERSION_MAJOR(create_info->applicationInfo.apiVersion) != 1)
+	{
+		return XR_ERROR_API_VERSION_UNSUPPORTED;
+	}
+
+	auto* mock_instance = new MockInstance();
+	for (uint32_t i = 0; i < create_info->enabledExtensionCount; ++i)
+	{
+		const char* name = create_info->enabledExtensionNames[i];
+		const bool supported = std::any_of(std::begin(c_supported_extensions), std::end(c_supported_extensions),
+			[name](const char* supported_name) { return strcmp(supported_name, name) == 0; });
+		if (!supported)
+		{
+			delete mock_instance;
+			return XR_ERROR_EXTENSION_NOT_PRESENT;
+		}
+		mock_instance->enabled_extensions.push_back(name);
+	}
+
+	g_mock.config = load_config();
+	if (!g_mock.config.pose_script.empty())
+	{
+		load_pose_script(mock_instance, g_mock.config.pose_script);
+	}
+
+	g_mock.instance = mock_instance;
+	*instance = to_handle<XrInstance>(mock_instance);
+	return XR_SUCCESS;
+}
+
+static void destroy_swapchain(MockSwapchain* swapchain)
+{
+	glDeleteTextures((GLsizei)swapchain->images.size(), swapchain->images.data());
+	destroy_handle(swapchain);
+}
+
+static void destroy_session(MockSession* session)
+{
+	for (MockSpace* space : session->spaces)
+	{
+		destroy_handle(space);
+	}
+	for (MockSwapchain* swapchain : session->swapchains)
+	{
+		destroy_swapchain(swapchain);
+	}
+	destroy_handle(session);
+}
+
+static XrResult XRAPI_CALL mock_xrDestroyInstance(XrInstance instance)
+{
+	MockLock lock;
+
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	for (MockSession* session : mock_instance->sessions)
+	{
+		destroy_session(session);
+	}
+	for (MockAction* action : mock_instance->actions)
+	{
+		destroy_handle(action);
+	}
+	for (MockActionSet* action_set : mock_instance->action_sets)
+	{
+		destroy_handle(action_set);
+	}
+	for (MockMessenger* messenger : mock_instance->messengers)
+	{
+		destroy_handle(messenger);
+	}
+
+	g_mock.instance = nullptr;
+	destroy_handle(mock_instance);
+	g_mock.frame_cv.notify_all();
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetInstanceProperties(XrInstance instance, XrInstanceProperties* properties)
+{
+	MockLock lock;
+	if (from_handle<MockInstance>(instance) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	properties->runtimeVersion = XR_MAKE_VERSION(0, 1, 0);
+	snprintf(properties->runtimeName, XR_MAX_RUNTIME_NAME_SIZE, "%s", "rlOpenXR Mock Runtime");
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrResultToString(XrInstance /*instance*/, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE])
+{
+#define RLOPENXR_MOCK_RESULT_CASE(name, val) case name: snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "%s", #name); return XR_SUCCESS;
+	switch (value)
+	{
+		XR_LIST_ENUM_XrResult(RLOPENXR_MOCK_RESULT_CASE)
+	default:
+		snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "%s_%d", XR_SUCCEEDED(value) ? "XR_UNKNOWN_SUCCESS" : "XR_UNKNOWN_FAILURE", (int)value);
+		return XR_SUCCESS;
+	}
+#undef RLOPENXR_MOCK_RESULT_CASE
+}
+
+static XrResult XRAPI_CALL mock_xrStructureTypeToString(XrInstance /*instance*/, XrStructureType value, char buffer[XR_MAX_STRUCTURE_NAME_SIZE])
+{
+#define RLOPENXR_MOCK_STRUCTURE_CASE(name, val) case name: snprintf(buffer, XR_MAX_STRUCTURE_NAME_SIZE, "%s", #name); return XR_SUCCESS;
+	switch (value)
+	{
+		XR_LIST_ENUM_XrStructureType(RLOPENXR_MOCK_STRUCTURE_CASE)
+	default:
+		snprintf(buffer, XR_MAX_STRUCTURE_NAME_SIZE, "XR_UNKNOWN_STRUCTURE_TYPE_%d", (int)value);
+		return XR_SUCCESS;
+	}
+#undef RLOPENXR_MOCK_STRUCTURE_CASE
+}
+
+static XrResult XRAPI_CALL mock_xrPollEvent(XrInstance instance, XrEventDataBuffer* event_data)
+{
+	MockLock lock;
+
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (mock_instance->events.empty())
+	{
+		return XR_EVENT_UNAVAILABLE;
+	}
+
+	*event_data = mock_instance->events.front();
+	mock_instance->events.pop_front();
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetSystem(XrInstance instance, const XrSystemGetInfo* get_info, XrSystemId* system_id)
+{
+	MockLock lock;
+	if (from_handle<MockInstance>(instance) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (get_info->formFactor != XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY)
+	{
+		return XR_ERROR_FORM_FACTOR_UNSUPPORTED;
+	}
+
+	*system_id = c_system_id;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetSystemProperties(XrInstance instance, XrSystemId system_id, XrSystemProperties* properties)
+{
+	MockLock lock;
+	if (from_handle<MockInstance>(instance) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (system_id != c_system_id)
+	{
+		return XR_ERROR_SYSTEM_INVALID;
+	}
+
+	for (auto* next = (XrBaseOutStructure*)properties->next; next != nullptr; next = next->next)
+	{
+		if (next->type == XR_TYPE_SYSTEM_SPACE_WARP_PROPERTIES_FB && extension_enabled(from_handle<MockInstance>(instance), XR_FB_SPACE_WARP_EXTENSION_NAME))
+		{
+			// Quarter of the pixels, like the runtimes shipping the extension
+			auto* space_warp_properties = (XrSystemSpaceWarpPropertiesFB*)next;
+			space_warp_properties->recommendedMotionVectorImageRectWidth = g_mock.config.view_width / 2;
+			space_warp_properties->recommendedMotionVectorImageRectHeight = g_mock.config.view_height / 2;
+		}
+	}
+
+	properties->systemId = c_system_id;
+	properties->vendorId = 0;
+	snprintf(properties->systemName, XR_MAX_SYSTEM_NAME_SIZE, "%s", "rlOpenXR Mock HMD");
+	properties->graphicsProperties.maxLayerCount = c_max_layer_count;
+	properties->graphicsProperties.maxSwapchainImageWidth = g_mock.config.view_width * 4;
+	properties->graphicsProperties.maxSwapchainImageHeight = g_mock.config.view_height * 2;
+	properties->trackingProperties.orientationTracking = XR_TRUE;
+	properties->trackingProperties.positionTracking = XR_TRUE;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateViewConfigurations(XrInstance /*instance*/, XrSystemId system_id, uint32_t capacity, uint32_t* count_output, XrViewConfigurationType* types)
+{
+	if (system_id != c_system_id)
+	{
+		return XR_ERROR_SYSTEM_INVALID;
+	}
+	const XrViewConfigurationType supported = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+	return two_call(capacity, count_output, types, &supported, 1);
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateViewConfigurationViews(XrInstance instance, XrSystemId system_id, XrViewConfigurationType type, uint32_t capacity, uint32_t* count_output, XrViewConfigurationView* views)
+{
+	MockLock lock;
+	if (from_handle<MockInstance>(instance) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (system_id != c_system_id)
+	{
+		return XR_ERROR_SYSTEM_INVALID;
+	}
+	if (type != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO)
+	{
+		return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+	}
+
+	*count_output = c_view_count;
+	if (capacity == 0)
+	{
+		return XR_SUCCESS;
+	}
+	if (capacity < c_view_count)
+	{
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	}
+
+	for (uint32_t i = 0; i < c_view_count; ++i)
+	{
+		views[i].recommendedImageRectWidth = g_mock.config.view_width;
+		views[i].recommendedImageRectHeight = g_mock.config.view_height;
+		views[i].maxImageRectWidth = g_mock.config.view_width * 2;
+		views[i].maxImageRectHeight = g_mock.config.view_height * 2;
+		views[i].recommendedSwapchainSampleCount = 1;
+		views[i].maxSwapchainSampleCount = 1;
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateEnvironmentBlendModes(XrInstance /*instance*/, XrSystemId system_id, XrViewConfigurationType /*type*/, uint32_t capacity, uint32_t* count_output, XrEnvironmentBlendMode* modes)
+{
+	if (system_id != c_system_id)
+	{
+		return XR_ERROR_SYSTEM_INVALID;
+	}
+	const XrEnvironmentBlendMode supported = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+	return two_call(capacity, count_output, modes, &supported, 1);
+}
+
+static XrResult XRAPI_CALL mock_xrGetOpenGLGraphicsRequirementsKHR(XrInstance instance, XrSystemId system_id, XrGraphicsRequirementsOpenGLKHR* requirements)
+{
+	MockLock lock;
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (system_id != c_system_id)
+	{
+		return XR_ERROR_SYSTEM_INVALID;
+	}
+
+	mock_instance->graphics_requirements_queried = true;
+	requirements->minApiVersionSupported = XR_MAKE_VERSION(3, 3, 0);
+	requirements->maxApiVersionSupported = XR_MAKE_VERSION(4, 6, 0);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrConvertTimespecTimeToTimeKHR(XrInstance /*instance*/, const struct timespec* timespec_time, XrTime* time)
+{
+	*time = (XrTime)timespec_time->tv_sec * 1'000'000'000 + timespec_time->tv_nsec;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrConvertTimeToTimespecTimeKHR(XrInstance /*instance*/, XrTime time, struct timespec* timespec_time)
+{
+	timespec_time->tv_sec = time / 1'000'000'000;
+	timespec_time->tv_nsec = time % 1'000'000'000;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateDebugUtilsMessengerEXT(XrInstance instance, const XrDebugUtilsMessengerCreateInfoEXT* create_info, XrDebugUtilsMessengerEXT* messenger)
+{
+	MockLock lock;
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	auto* mock_messenger = new MockMessenger{ mock_instance, create_info->messageSeverities, create_info->userCallback, create_info->userData };
+	mock_instance->messengers.push_back(mock_messenger);
+	*messenger = to_handle<XrDebugUtilsMessengerEXT>(mock_messenger);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroyDebugUtilsMessengerEXT(XrDebugUtilsMessengerEXT messenger)
+{
+	MockLock lock;
+	MockMessenger* mock_messenger = from_handle<MockMessenger>(messenger);
+	if (mock_messenger == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	auto& messengers = mock_messenger->instance->messengers;
+	messengers.erase(std::remove(messengers.begin(), messengers.end(), mock_messenger), messengers.end());
+	destroy_handle(mock_messenger);
+	return XR_SUCCESS;
+}
+
+// Session
+static XrResult XRAPI_CALL mock_xrCreateSession(XrInstance instance, const XrSessionCreateInfo* create_info, XrSession* session)
+{
+	MockLock lock;
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (create_info->systemId != c_system_id)
+	{
+		return XR_ERROR_SYSTEM_INVALID;
+	}
+	if (!mock_instance->graphics_requirements_queried)
+	{
+		return XR_ERROR_GRAPHICS_REQUIREMENTS_CALL_MISSING;
+	}
+
+	bool has_graphics_binding = false;
+	for (auto* next = (const XrBaseInStructure*)create_info->next; next != nullptr; next = next->next)
+	{
+		if ((next->type == XR_TYPE_GRAPHICS_BINDING_OPENGL_XLIB_KHR && extension_enabled(mock_instance, XR_KHR_OPENGL_ENABLE_EXTENSION_NAME)) ||
+			(next->type == XR_TYPE_GRAPHICS_BINDING_EGL_MNDX && extension_enabled(mock_instance, XR_MNDX_EGL_ENABLE_EXTENSION_NAME)))
+		{
+			has_graphics_binding = true;
+		}
+	}
+	if (!has_graphics_binding)
+	{
+		return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+	}
+
+	auto* mock_session = new MockSession();
+	mock_session->instance = mock_instance;
+	mock_session->epoch = now_xr_time();
+	mock_instance->sessions.push_back(mock_session);
+	*session = to_handle<XrSession>(mock_session);
+
+	push_session_state(mock_session, XR_SESSION_STATE_IDLE);
+	push_session_state(mock_session, XR_SESSION_STATE_READY);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroySession(XrSession session)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	auto& sessions = mock_session->instance->sessions;
+	sessions.erase(std::remove(sessions.begin(), sessions.end(), mock_session), sessions.end());
+	destroy_session(mock_session);
+	g_mock.frame_cv.notify_all();
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrBeginSession(XrSession session, const XrSessionBeginInfo* begin_info)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (begin_info->primaryViewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO)
+	{
+		return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+	}
+	if (mock_session->running)
+	{
+		return XR_ERROR_SESSION_RUNNING;
+	}
+	if (mock_session->state != XR_SESSION_STATE_READY)
+	{
+		return XR_ERROR_SESSION_NOT_READY;
+	}
+
+	mock_session->running = true;
+	mock_session->epoch = now_xr_time();
+	mock_session->frame_index = -1;
+
+	push_session_state(mock_session, XR_SESSION_STATE_SYNCHRONIZED);
+	push_session_state(mock_session, XR_SESSION_STATE_VISIBLE);
+	push_session_state(mock_session, XR_SESSION_STATE_FOCUSED);
+	return XR_SUCCESS;
+}
+
+static void request_exit(MockSession* session)
+{
+	session->exit_requested = true;
+	push_session_state(session, XR_SESSION_STATE_VISIBLE);
+	push_session_state(session, XR_SESSION_STATE_SYNCHRONIZED);
+	push_session_state(session, XR_SESSION_STATE_STOPPING);
+}
+
+static XrResult XRAPI_CALL mock_xrRequestExitSession(XrSession session)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (!mock_session->running)
+	{
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	}
+
+	if (!mock_session->exit_requested)
+	{
+		request_exit(mock_session);
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEndSession(XrSession session)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (!mock_session->running)
+	{
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	}
+	if (mock_session->state != XR_SESSION_STATE_STOPPING)
+	{
+		return XR_ERROR_SESSION_NOT_STOPPING;
+	}
+
+	mock_session->running = false;
+	g_mock.frame_cv.notify_all();
+
+	push_session_state(mock_session, XR_SESSION_STATE_IDLE);
+	push_session_state(mock_session, XR_SESSION_STATE_EXITING);
+	return XR_SUCCESS;
+}
+
+// Frame loop
+static XrResult XRAPI_CALL mock_xrWaitFrame(XrSession session, const XrFrameWaitInfo* /*wait_info*/, XrFrameState* frame_state)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	// A frame that has been waited on, but not begun, blocks the next wait
+	g_mock.frame_cv.wait(lock.lock, [&] {
+		return from_handle<MockSession>(session) == nullptr || !mock_session->running || mock_session->frames_waited == mock_session->frames_begun;
+	});
+	if (from_handle<MockSession>(session) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (!mock_session->running)
+	{
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	}
+
+	const MockConfig& config = g_mock.config;
+	int64_t frame_index = mock_session->frame_index + 1;
+
+	if (config.realtime)
+	{
+		// When the app is too slow, skip to the first frame it can still make. This shows up as a missed frame on the app side.
+		const XrTime now = now_xr_time();
+		while (predicted_display_time(mock_session, frame_index) - config.display_period < now - config.display_period)
+		{
+			++frame_index;
+		}
+	}
+
+	const XrTime display_time = predicted_display_time(mock_session, frame_index);
+	mock_session->frame_index = frame_index;
+	mock_session->frames_waited++;
+	mock_session->waited_display_time = display_time;
+
+	frame_state->predictedDisplayTime = display_time;
+	frame_state->predictedDisplayPeriod = config.display_period;
+	frame_state->shouldRender = (mock_session->state == XR_SESSION_STATE_VISIBLE || mock_session->state == XR_SESSION_STATE_FOCUSED) ? XR_TRUE : XR_FALSE;
+
+	lock.unlock();
+
+	// Wake up one display period before the predicted display time, like a compositor would
+	if (config.realtime)
+	{
+		sleep_until_xr_time(display_time - config.display_period);
+	}
+
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrBeginFrame(XrSession session, const XrFrameBeginInfo* /*begin_info*/)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (!mock_session->running)
+	{
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	}
+	if (mock_session->frames_waited == mock_session->frames_begun)
+	{
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+
+	const XrResult result = mock_session->frame_in_progress ? XR_FRAME_DISCARDED : XR_SUCCESS;
+
+	mock_session->frame_in_progress = true;
+	mock_session->frames_begun = mock_session->frames_waited;
+	mock_session->begun_display_time = mock_session->waited_display_time;
+	g_mock.frame_cv.notify_all();
+	return result;
+}
+
+static XrResult XRAPI_CALL mock_xrEndFrame(XrSession session, const XrFrameEndInfo* end_info)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (!mock_session->running)
+	{
+		return XR_ERROR_SESSION_NOT_RUNNING;
+	}
+	if (!mock_session->frame_in_progress)
+	{
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+	if (end_info->displayTime != mock_session->begun_display_time)
+	{
+		report(XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrEndFrame: displayTime %lld does not match the predicted display time %lld",
+			(long long)end_info->displayTime, (long long)mock_session->begun_display_time);
+		return XR_ERROR_TIME_INVALID;
+	}
+	if (end_info->environmentBlendMode != XR_ENVIRONMENT_BLEND_MODE_OPAQUE)
+	{
+		return XR_ERROR_ENVIRONMENT_BLEND_MODE_UNSUPPORTED;
+	}
+	if (end_info->layerCount > c_max_layer_count)
+	{
+		return XR_ERROR_LAYER_LIMIT_EXCEEDED;
+	}
+
+	for (uint32_t i = 0; i < end_info->layerCount; ++i)
+	{
+		const XrResult result = validate_layer(mock_session->instance, end_info->layers[i]);
+		if (XR_FAILED(result))
+		{
+			return result;
+		}
+	}
+
+	mock_session->frame_in_progress = false;
+	mock_session->frames_ended++;
+
+	const uint64_t exit_after_frames = g_mock.config.exit_after_frames;
+	if (exit_after_frames != 0 && mock_session->frames_ended >= exit_after_frames && !mock_session->exit_requested)
+	{
+		request_exit(mock_session);
+	}
+
+	return XR_SUCCESS;
+}
+
+// Spaces
+static XrResult XRAPI_CALL mock_xrEnumerateReferenceSpaces(XrSession session, uint32_t capacity, uint32_t* count_output, XrReferenceSpaceType* spaces)
+{
+	MockLock lock;
+	if (from_handle<MockSession>(session) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	const XrReferenceSpaceType supported[] = { XR_REFERENCE_SPACE_TYPE_VIEW, XR_REFERENCE_SPACE_TYPE_LOCAL, XR_REFERENCE_SPACE_TYPE_STAGE };
+	return two_call(capacity, count_output, spaces, supported, (uint32_t)std::size(supported));
+}
+
+static XrResult XRAPI_CALL mock_xrCreateReferenceSpace(XrSession session, const XrReferenceSpaceCreateInfo* create_info, XrSpace* space)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	switch (create_info->referenceSpaceType)
+	{
+	case XR_REFERENCE_SPACE_TYPE_VIEW:
+	case XR_REFERENCE_SPACE_TYPE_LOCAL:
+	case XR_REFERENCE_SPACE_TYPE_STAGE: break;
+	default: return XR_ERROR_REFERENCE_SPACE_UNSUPPORTED;
+	}
+
+	auto* mock_space = new MockSpace();
+	mock_space->session = mock_session;
+	mock_space->reference_type = create_info->referenceSpaceType;
+	mock_space->offset = create_info->poseInReferenceSpace;
+	mock_session->spaces.push_back(mock_space);
+	*space = to_handle<XrSpace>(mock_space);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetReferenceSpaceBoundsRect(XrSession session, XrReferenceSpaceType /*type*/, XrExtent2Df* bounds)
+{
+	MockLock lock;
+	if (from_handle<MockSession>(session) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	*bounds = XrExtent2Df{ 0, 0 };
+	return XR_SPACE_BOUNDS_UNAVAILABLE;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateActionSpace(XrSession session, const XrActionSpaceCreateInfo* create_info, XrSpace* space)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	MockAction* mock_action = from_handle<MockAction>(create_info->action);
+	if (mock_session == nullptr || mock_action == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (mock_action->type != XR_ACTION_TYPE_POSE_INPUT)
+	{
+		return XR_ERROR_ACTION_TYPE_MISMATCH;
+	}
+
+	auto* mock_space = new MockSpace();
+	mock_space->session = mock_session;
+	mock_space->is_action_space = true;
+	mock_space->action = mock_action;
+	mock_space->subaction_path = create_info->subactionPath;
+	mock_space->offset = create_info->poseInActionSpace;
+	mock_session->spaces.push_back(mock_space);
+	*space = to_handle<XrSpace>(mock_space);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroySpace(XrSpace space)
+{
+	MockLock lock;
+	MockSpace* mock_space = from_handle<MockSpace>(space);
+	if (mock_space == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	auto& spaces = mock_space->session->spaces;
+	spaces.erase(std::remove(spaces.begin(), spaces.end(), mock_space), spaces.end());
+	destroy_handle(mock_space);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrLocateSpace(XrSpace space, XrSpace base_space, XrTime time, XrSpaceLocation* location)
+{
+	MockLock lock;
+	MockSpace* mock_space = from_handle<MockSpace>(space);
+	MockSpace* mock_base_space = from_handle<MockSpace>(base_space);
+	if (mock_space == nullptr || mock_base_space == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (time <= 0)
+	{
+		return XR_ERROR_TIME_INVALID;
+	}
+
+	location->pose = pose_multiply(pose_inverse(space_pose(mock_base_space, time)), space_pose(mock_space, time));
+	location->locationFlags = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT |
+		XR_SPACE_LOCATION_POSITION_TRACKED_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrLocateViews(XrSession session, const XrViewLocateInfo* locate_info, XrViewState* view_state, uint32_t capacity, uint32_t* count_output, XrView* views)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	MockSpace* mock_space = from_handle<MockSpace>(locate_info->space);
+	if (mock_session == nullptr || mock_space == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (locate_info->viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO)
+	{
+		return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+	}
+	if (locate_info->displayTime <= 0)
+	{
+		return XR_ERROR_TIME_INVALID;
+	}
+
+	*count_output = c_view_count;
+	if (capacity == 0)
+	{
+		return XR_SUCCESS;
+	}
+	if (capacity < c_view_count)
+	{
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	}
+
+	const XrPosef base_inverse = pose_inverse(space_pose(mock_space, locate_info->displayTime));
+	for (uint32_t i = 0; i < c_view_count; ++i)
+	{
+		views[i].pose = pose_multiply(base_inverse, eye_pose(mock_session, i, locate_info->displayTime));
+		views[i].fov = eye_fov(i);
+	}
+
+	view_state->viewStateFlags = XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_VALID_BIT |
+		XR_VIEW_STATE_POSITION_TRACKED_BIT | XR_VIEW_STATE_ORIENTATION_TRACKED_BIT;
+	return XR_SUCCESS;
+}
+
+// Swapchains
+static XrResult XRAPI_CALL mock_xrEnumerateSwapchainFormats(XrSession session, uint32_t capacity, uint32_t* count_output, int64_t* formats)
+{
+	MockLock lock;
+	if (from_handle<MockSession>(session) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	return two_call(capacity, count_output, formats, c_swapchain_formats, (uint32_t)std::size(c_swapchain_formats));
+}
+
+static XrResult XRAPI_CALL mock_xrCreateSwapchain(XrSession session, const XrSwapchainCreateInfo* create_info, XrSwapchain* swapchain)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (std::find(std::begin(c_swapchain_formats), std::end(c_swapchain_formats), create_info->format) == std::end(c_swapchain_formats))
+	{
+		return XR_ERROR_SWAPCHAIN_FORMAT_UNSUPPORTED;
+	}
+	if (create_info->sampleCount != 1 || create_info->faceCount != 1 || create_info->mipCount != 1)
+	{
+		return XR_ERROR_FEATURE_UNSUPPORTED;
+	}
+	if (create_info->width == 0 || create_info->height == 0 || create_info->arraySize == 0 ||
+		create_info->width > g_mock.config.view_width * 4 || create_info->height > g_mock.config.view_height * 2)
+	{
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	}
+	if (is_depth_format(create_info->format) && (create_info->usageFlags & XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT))
+	{
+		return MOCK_VALIDATION_ERROR("xrCreateSwapchain: depth format used with XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT");
+	}
+
+	auto* mock_swapchain = new MockSwapchain();
+	mock_swapchain->session = mock_session;
+	mock_swapchain->info = *create_info;
+	mock_swapchain->info.next = nullptr;
+
+	const uint32_t image_count = (create_info->createFlags & XR_SWAPCHAIN_CREATE_STATIC_IMAGE_BIT) ? 1 : c_swapchain_image_count;
+	mock_swapchain->images.resize(image_count);
+	glGenTextures((GLsizei)image_count, mock_swapchain->images.data());
+
+	GLenum upload_format, upload_type;
+	gl_upload_format(create_info->format, &upload_format, &upload_type);
+	const GLenum target = create_info->arraySize > 1 ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+
+	for (uint32_t image : mock_swapchain->images)
+	{
+		glBindTexture(target, image);
+		glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		if (target == GL_TEXTURE_2D_ARRAY)
+		{
+			glTexImage3D(target, 0, (GLint)create_info->format, (GLsizei)create_info->width, (GLsizei)create_info->height,
+				(GLsizei)create_info->arraySize, 0, upload_format, upload_type, nullptr);
+		}
+		else
+		{
+			glTexImage2D(target, 0, (GLint)create_info->format, (GLsizei)create_info->width, (GLsizei)create_info->height,
+				0, upload_format, upload_type, nullptr);
+		}
+	}
+	glBindTexture(target, 0);
+
+	mock_session->swapchains.push_back(mock_swapchain);
+	*swapchain = to_handle<XrSwapchain>(mock_swapchain);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroySwapchain(XrSwapchain swapchain)
+{
+	MockLock lock;
+	MockSwapchain* mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	if (mock_swapchain == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	auto& swapchains = mock_swapchain->session->swapchains;
+	swapchains.erase(std::remove(swapchains.begin(), swapchains.end(), mock_swapchain), swapchains.end());
+	destroy_swapchain(mock_swapchain);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrEnumerateSwapchainImages(XrSwapchain swapchain, uint32_t capacity, uint32_t* count_output, XrSwapchainImageBaseHeader* images)
+{
+	MockLock lock;
+	MockSwapchain* mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	if (mock_swapchain == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	const uint32_t image_count = (uint32_t)mock_swapchain->images.size();
+	*count_output = image_count;
+	if (capacity == 0)
+	{
+		return XR_SUCCESS;
+	}
+	if (capacity < image_count)
+	{
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	}
+	if (images[0].type != XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR)
+	{
+		return XR_ERROR_VALIDATION_FAILURE;
+	}
+
+	auto* gl_images = (XrSwapchainImageOpenGLKHR*)images;
+	for (uint32_t i = 0; i < image_count; ++i)
+	{
+		gl_images[i].image = mock_swapchain->images[i];
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrAcquireSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageAcquireInfo* /*acquire_info*/, uint32_t* index)
+{
+	MockLock lock;
+	MockSwapchain* mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	if (mock_swapchain == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (mock_swapchain->acquired.size() == mock_swapchain->images.size())
+	{
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+	if ((mock_swapchain->info.createFlags & XR_SWAPCHAIN_CREATE_STATIC_IMAGE_BIT) && mock_swapchain->acquire_count > 0)
+	{
+		return MOCK_VALIDATION_ERROR("xrAcquireSwapchainImage: swapchain with XR_SWAPCHAIN_CREATE_STATIC_IMAGE_BIT acquired twice");
+	}
+
+	*index = mock_swapchain->next_image;
+	mock_swapchain->acquired.push_back(mock_swapchain->next_image);
+	mock_swapchain->next_image = (mock_swapchain->next_image + 1) % (uint32_t)mock_swapchain->images.size();
+	mock_swapchain->acquire_count++;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrWaitSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageWaitInfo* /*wait_info*/)
+{
+	MockLock lock;
+	MockSwapchain* mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	if (mock_swapchain == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (mock_swapchain->waited_count >= mock_swapchain->acquired.size())
+	{
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+
+	// Images are never in use by a compositor, so they are available immediately
+	mock_swapchain->waited_count++;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrReleaseSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* /*release_info*/)
+{
+	MockLock lock;
+	MockSwapchain* mock_swapchain = from_handle<MockSwapchain>(swapchain);
+	if (mock_swapchain == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (mock_swapchain->waited_count == 0)
+	{
+		return XR_ERROR_CALL_ORDER_INVALID;
+	}
+
+	mock_swapchain->acquired.pop_front();
+	mock_swapchain->waited_count--;
+	mock_swapchain->has_released_image = true;
+	return XR_SUCCESS;
+}
+
+// Paths
+static XrResult XRAPI_CALL mock_xrStringToPath(XrInstance instance, const char* path_string, XrPath* path)
+{
+	MockLock lock;
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	const size_t length = strlen(path_string);
+	if (length == 0 || path_string[0] != '/' || path_string[length - 1] == '/' || length >= XR_MAX_PATH_LENGTH)
+	{
+		return XR_ERROR_PATH_FORMAT_INVALID;
+	}
+
+	auto [it, inserted] = mock_instance->path_lookup.try_emplace(path_string, (XrPath)mock_instance->paths.size() + 1);
+	if (inserted)
+	{
+		mock_instance->paths.push_back(path_string);
+	}
+	*path = it->second;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrPathToString(XrInstance instance, XrPath path, uint32_t capacity, uint32_t* count_output, char* buffer)
+{
+	MockLock lock;
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (path == XR_NULL_PATH || path > mock_instance->paths.size())
+	{
+		return XR_ERROR_PATH_INVALID;
+	}
+
+	const std::string& string = mock_instance->paths[path - 1];
+	*count_output = (uint32_t)string.size() + 1;
+	if (capacity == 0)
+	{
+		return XR_SUCCESS;
+	}
+	if (capacity < *count_output)
+	{
+		return XR_ERROR_SIZE_INSUFFICIENT;
+	}
+	memcpy(buffer, string.c_str(), string.size() + 1);
+	return XR_SUCCESS;
+}
+
+// Actions
+static XrResult XRAPI_CALL mock_xrCreateActionSet(XrInstance instance, const XrActionSetCreateInfo* create_info, XrActionSet* action_set)
+{
+	MockLock lock;
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	auto* mock_action_set = new MockActionSet();
+	mock_action_set->instance = mock_instance;
+	mock_action_set->name = create_info->actionSetName;
+	mock_instance->action_sets.push_back(mock_action_set);
+	*action_set = to_handle<XrActionSet>(mock_action_set);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroyActionSet(XrActionSet action_set)
+{
+	MockLock lock;
+	MockActionSet* mock_action_set = from_handle<MockActionSet>(action_set);
+	if (mock_action_set == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	auto& action_sets = mock_action_set->instance->action_sets;
+	action_sets.erase(std::remove(action_sets.begin(), action_sets.end(), mock_action_set), action_sets.end());
+	destroy_handle(mock_action_set);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrCreateAction(XrActionSet action_set, const XrActionCreateInfo* create_info, XrAction* action)
+{
+	MockLock lock;
+	MockActionSet* mock_action_set = from_handle<MockActionSet>(action_set);
+	if (mock_action_set == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (mock_action_set->attached)
+	{
+		return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+	}
+
+	auto* mock_action = new MockAction();
+	mock_action->action_set = mock_action_set;
+	mock_action->name = create_info->actionName;
+	mock_action->type = create_info->actionType;
+	mock_action->subaction_paths.assign(create_info->subactionPaths, create_info->subactionPaths + create_info->countSubactionPaths);
+	mock_action_set->instance->actions.push_back(mock_action);
+	*action = to_handle<XrAction>(mock_action);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrDestroyAction(XrAction action)
+{
+	MockLock lock;
+	MockAction* mock_action = from_handle<MockAction>(action);
+	if (mock_action == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	auto& actions = mock_action->action_set->instance->actions;
+	actions.erase(std::remove(actions.begin(), actions.end(), mock_action), actions.end());
+	destroy_handle(mock_action);
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrSuggestInteractionProfileBindings(XrInstance instance, const XrInteractionProfileSuggestedBinding* suggested_bindings)
+{
+	MockLock lock;
+	MockInstance* mock_instance = from_handle<MockInstance>(instance);
+	if (mock_instance == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	const std::string& profile = path_string(mock_instance, suggested_bindings->interactionProfile);
+	if (profile.rfind("/interaction_profiles/", 0) != 0)
+	{
+		return XR_ERROR_PATH_UNSUPPORTED;
+	}
+
+	for (uint32_t i = 0; i < suggested_bindings->countSuggestedBindings; ++i)
+	{
+		const XrActionSuggestedBinding& binding = suggested_bindings->suggestedBindings[i];
+		MockAction* mock_action = from_handle<MockAction>(binding.action);
+		if (mock_action == nullptr)
+		{
+			return XR_ERROR_HANDLE_INVALID;
+		}
+		if (mock_action->action_set->attached)
+		{
+			return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+		}
+		if (path_string(mock_instance, binding.binding).rfind("/user/", 0) != 0)
+		{
+			return XR_ERROR_PATH_UNSUPPORTED;
+		}
+	}
+
+	// The mock "controllers" pretend to be whatever profile was suggested last
+	mock_instance->suggested_profile = suggested_bindings->interactionProfile;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrAttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo* attach_info)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	for (uint32_t i = 0; i < attach_info->countActionSets; ++i)
+	{
+		MockActionSet* mock_action_set = from_handle<MockActionSet>(attach_info->actionSets[i]);
+		if (mock_action_set == nullptr)
+		{
+			return XR_ERROR_HANDLE_INVALID;
+		}
+		if (mock_action_set->attached)
+		{
+			return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+		}
+	}
+	for (uint32_t i = 0; i < attach_info->countActionSets; ++i)
+	{
+		from_handle<MockActionSet>(attach_info->actionSets[i])->attached = true;
+	}
+
+	XrEventDataInteractionProfileChanged event{ XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED };
+	event.session = session;
+	push_event(mock_session->instance, &event, sizeof(event));
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetCurrentInteractionProfile(XrSession session, XrPath top_level_user_path, XrInteractionProfileState* interaction_profile)
+{
+	MockLock lock;
+	MockSession* mock_session = from_handle<MockSession>(session);
+	if (mock_session == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if (path_string(mock_session->instance, top_level_user_path).rfind("/user/", 0) != 0)
+	{
+		return XR_ERROR_PATH_UNSUPPORTED;
+	}
+
+	interaction_profile->interactionProfile = mock_session->instance->suggested_profile;
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrSyncActions(XrSession session, const XrActionsSyncInfo* sync_info)
+{
+	MockLock lock;
+	if (from_handle<MockSession>(session) == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+
+	for (uint32_t i = 0; i < sync_info->countActiveActionSets; ++i)
+	{
+		MockActionSet* mock_action_set = from_handle<MockActionSet>(sync_info->activeActionSets[i].actionSet);
+		if (mock_action_set == nullptr)
+		{
+			return XR_ERROR_HANDLE_INVALID;
+		}
+		if (!mock_action_set->attached)
+		{
+			return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+		}
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult get_action(const XrActionStateGetInfo* get_info, XrActionType type, MockAction** action)
+{
+	*action = from_handle<MockAction>(get_info->action);
+	if (*action == nullptr)
+	{
+		return XR_ERROR_HANDLE_INVALID;
+	}
+	if ((*action)->type != type)
+	{
+		return XR_ERROR_ACTION_TYPE_MISMATCH;
+	}
+	if (!(*action)->action_set->attached)
+	{
+		return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+	}
+	if (get_info->subactionPath != XR_NULL_PATH &&
+		std::find((*action)->subaction_paths.begin(), (*action)->subaction_paths.end(), get_info->subactionPath) == (*action)->subaction_paths.end())
+	{
+		return XR_ERROR_PATH_UNSUPPORTED;
+	}
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrGetActionStateBoolean(XrSession /*session*/, const XrActionStateGetInfo* get_info, XrActionStateBoolean* state)
+{
+	MockLock lock;
+	MockAction* action;
+	const XrResult result = get_action(get_info, XR_ACTION_TYPE_BOOLEAN_INPUT, &action);
+	if (XR_SUCCEEDED(result))
+	{
+		state->currentState = XR_FALSE;
+		state->changedSinceLastSync = XR_FALSE;
+		state->lastChangeTime = 0;
+		state->isActive = XR_TRUE;
+	}
+	return result;
+}
+
+static XrResult XRAPI_CALL mock_xrGetActionStateFloat(XrSession /*session*/, const XrActionStateGetInfo* get_info, XrActionStateFloat* state)
+{
+	MockLock lock;
+	MockAction* action;
+	const XrResult result = get_action(get_info, XR_ACTION_TYPE_FLOAT_INPUT, &action);
+	if (XR_SUCCEEDED(result))
+	{
+		state->currentState = 0.f;
+		state->changedSinceLastSync = XR_FALSE;
+		state->lastChangeTime = 0;
+		state->isActive = XR_TRUE;
+	}
+	return result;
+}
+
+static XrResult XRAPI_CALL mock_xrGetActionStateVector2f(XrSession /*session*/, const XrActionStateGetInfo* get_info, XrActionStateVector2f* state)
+{
+	MockLock lock;
+	MockAction* action;
+	const XrResult result = get_action(get_info, XR_ACTION_TYPE_VECTOR2F_INPUT, &action);
+	if (XR_SUCCEEDED(result))
+	{
+		state->currentState = XrVector2f{ 0.f, 0.f };
+		state->changedSinceLastSync = XR_FALSE;
+		state->lastChangeTime = 0;
+		state->isActive = XR_TRUE;
+	}
+	return result;
+}
+
+static XrResult XRAPI_CALL mock_xrGetActionStatePose(XrSession /*session*/, const XrActionStateGetInfo* get_info, XrActionStatePose* state)
+{
+	MockLock lock;
+	MockAction* action;
+	const XrResult result = get_action(get_info, XR_ACTION_TYPE_POSE_INPUT, &action);
+	if (XR_SUCCEEDED(result))
+	{
+		state->isActive = XR_TRUE;
+	}
+	return result;
+}
+
+static XrResult XRAPI_CALL mock_xrApplyHapticFeedback(XrSession /*session*/, const XrHapticActionInfo* /*info*/, const XrHapticBaseHeader* /*feedback*/)
+{
+	return XR_SUCCESS;
+}
+
+static XrResult XRAPI_CALL mock_xrStopHapticFeedback(XrSession /*session*/, const XrHapticActionInfo* /*info*/)
+{
+	return XR_SUCCESS;
+}
+
+
+// Entry points
+// ============================================================================
+
+struct MockFunction
+{
+	const char* name;
+	PFN_xrVoidFunction function;
+	const char* extension; // nullptr for core functions
+};
+
+#define RLOPENXR_MOCK_FUNCTION(name) { #name, (PFN_xrVoidFunction)&mock_##name, nullptr }
+#define RLOPENXR_MOCK_EXTENSION_FUNCTION(name, extension) { #name, (PFN_xrVoidFunction)&mock_##name, extension }
+
+static XrResult XRAPI_CALL mock_xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function);
+
+static const MockFunction c_functions[] = {
+	RLOPENXR_MOCK_FUNCTION(xrGetInstanceProcAddr),
+	RLOPENXR_MOCK_FUNCTION(xrEnumerateApiLayerProperties),
+	RLOPENXR_MOCK_FUNCTION(xrEnumerateInstanceExtensionProperties),
+	RLOPENXR_MOCK_FUNCTION(xrCreateInstance),
+	RLOPENXR_MOCK_FUNCTION(xrDestroyInstance),
+	RLOPENXR_MOCK_FUNCTION(xrGetInstanceProperties),
+	RLOPENXR_MOCK_FUNCTION(xrPollEvent),
+	RLOPENXR_MOCK_FUNCTION(xrResultToString),
+	RLOPENXR_MOCK_FUNCTION(xrStructureTypeToString),
+	RLOPENXR_MOCK_FUNCTION(xrGetSystem),
+	RLOPENXR_MOCK_FUNCTION(xrGetSystemProperties),
+	RLOPENXR_MOCK_FUNCTION(xrEnumerateEnvironmentBlendModes),
+	RLOPENXR_MOCK_FUNCTION(xrCreateSession),
+	RLOPENXR_MOCK_FUNCTION(xrDestroySession),
+	RLOPENXR_MOCK_FUNCTION(xrEnumerateReferenceSpaces),
+	RLOPENXR_MOCK_FUNCTION(xrCreateReferenceSpace),
+	RLOPENXR_MOCK_FUNCTION(xrGetReferenceSpaceBoundsRect),
+	RLOPENXR_MOCK_FUNCTION(xrCreateActionSpace),
+	RLOPENXR_MOCK_FUNCTION(xrLocateSpace),
+	RLOPENXR_MOCK_FUNCTION(xrDestroySpace),
+	RLOPENXR_MOCK_FUNCTION(xrEnumerateViewConfigurations),
+	RLOPENXR_MOCK_FUNCTION(xrEnumerateViewConfigurationViews),
+	RLOPENXR_MOCK_FUNCTION(xrEnumerateSwapchainFormats),
+	RLOPENXR_MOCK_FUNCTION(xrCreateSwapchain),
+	RLOPENXR_MOCK_FUNCTION(xrDestroySwapchain),
+	RLOPENXR_MOCK_FUNCTION(xrEnumerateSwapchainImages),
+	RLOPENXR_MOCK_FUNCTION(xrAcquireSwapchainImage),
+	RLOPENXR_MOCK_FUNCTION(xrWaitSwapchainImage),
+	RLOPENXR_MOCK_FUNCTION(xrReleaseSwapchainImage),
+	RLOPENXR_MOCK_FUNCTION(xrBeginSession),
+	RLOPENXR_MOCK_FUNCTION(xrEndSession),
+	RLOPENXR_MOCK_FUNCTION(xrRequestExitSession),
+	RLOPENXR_MOCK_FUNCTION(xrWaitFrame),
+	RLOPENXR_MOCK_FUNCTION(xrBeginFrame),
+	RLOPENXR_MOCK_FUNCTION(xrEndFrame),
+	RLOPENXR_MOCK_FUNCTION(xrLocateViews),
+	RLOPENXR_MOCK_FUNCTION(xrStringToPath),
+	RLOPENXR_MOCK_FUNCTION(xrPathToString),
+	RLOPENXR_MOCK_FUNCTION(xrCreateActionSet),
+	RLOPENXR_MOCK_FUNCTION(xrDestroyActionSet),
+	RLOPENXR_MOCK_FUNCTION(xrCreateAction),
+	RLOPENXR_MOCK_FUNCTION(xrDestroyAction),
+	RLOPENXR_MOCK_FUNCTION(xrSuggestInteractionProfileBindings),
+	RLOPENXR_MOCK_FUNCTION(xrAttachSessionActionSets),
+	RLOPENXR_MOCK_FUNCTION(xrGetCurrentInteractionProfile),
+	RLOPENXR_MOCK_FUNCTION(xrGetActionStateBoolean),
+	RLOPENXR_MOCK_FUNCTION(xrGetActionStateFloat),
+	RLOPENXR_MOCK_FUNCTION(xrGetActionStateVector2f),
+	RLOPENXR_MOCK_FUNCTION(xrGetActionStatePose),
+	RLOPENXR_MOCK_FUNCTION(xrSyncActions),
+	RLOPENXR_MOCK_FUNCTION(xrApplyHapticFeedback),
+	RLOPENXR_MOCK_FUNCTION(xrStopHapticFeedback),
+
+	RLOPENXR_MOCK_EXTENSION_FUNCTION(xrGetOpenGLGraphicsRequirementsKHR, XR_KHR_OPENGL_ENABLE_EXTENSION_NAME),
+	RLOPENXR_MOCK_EXTENSION_FUNCTION(xrConvertTimespecTimeToTimeKHR, XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME),
+	RLOPENXR_MOCK_EXTENSION_FUNCTION(xrConvertTimeToTimespecTimeKHR, XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME),
+	RLOPENXR_MOCK_EXTENSION_FUNCTION(xrCreateDebugUtilsMessengerEXT, XR_EXT_DEBUG_UTILS_EXTENSION_NAME),
+	RLOPENXR_MOCK_EXTENSION_FUNCTION(xrDestroyDebugUtilsMessengerEXT, XR_EXT_DEBUG_UTILS_EXTENSION_NAME),
+};
+
+static XrResult XRAPI_CALL mock_xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function)
+{
+	*function = nullptr;
+
+	// Only these are allowed without an instance
+	if (instance == XR_NULL_HANDLE)
+	{
+		if (strcmp(name, "xrEnumerateInstanceExtensionProperties") != 0 &&
+			strcmp(name, "xrEnumerateApiLayerProperties") != 0 &&
+			strcmp(name, "xrCreateInstance") != 0)
+		{
+			return XR_ERROR_HANDLE_INVALID;
+		}
+	}
+
+	MockInstance* mock_instance = nullptr;
+	if (instance != XR_NULL_HANDLE)
+	{
+		MockLock lock;
+		mock_instance = from_handle<MockInstance>(instance);
+		if (mock_instance == nullptr)
+		{
+			return XR_ERROR_HANDLE_INVALID;
+		}
+	}
+
+	for (const MockFunction& entry : c_functions)
+	{
+		if (strcmp(entry.name, name) != 0)
+		{
+			continue;
+		}
+
+		if (entry.extension != nullptr && (mock_instance == nullptr || !extension_enabled(mock_instance, entry.extension)))
+		{
+			return XR_ERROR_FUNCTION_UNSUPPORTED;
+		}
+
+		*function = entry.function;
+		return XR_SUCCESS;
+	}
+
+	return XR_ERROR_FUNCTION_UNSUPPORTED;
+}
+
+extern "C" RLOPENXR_MOCK_EXPORT XrResult XRAPI_CALL xrNegotiateLoaderRuntimeInterface(const loader::XrNegotiateLoaderInfo* loader_info, loader::XrNegotiateRuntimeRequest* runtime_request)
+{
+	if (loader_info == nullptr || runtime_request == nullptr ||
+		loader_info->structType != loader::XR_LOADER_INTERFACE_STRUCT_LOADER_INFO ||
+		loader_info->structVersion != loader::XR_LOADER_INFO_STRUCT_VERSION ||
+		loader_info->structSize != sizeof(loader::XrNegotiateLoaderInfo) ||
+		runtime_request->structType != loader::XR_LOADER_INTERFACE_STRUCT_RUNTIME_REQUEST ||
+		runtime_request->structVersion != loader::XR_RUNTIME_INFO_STRUCT_VERSION ||
+		runtime_request->structSize != sizeof(loader::XrNegotiateRuntimeRequest))
+	{
+		return XR_ERROR_INITIALIZATION_FAILED;
+	}
+
+	if (loader_info->minInterfaceVersion > loader::XR_CURRENT_LOADER_RUNTIME_VERSION ||
+		loader_info->maxInterfaceVersion < loader::XR_CURRENT_LOADER_RUNTIME_VERSION ||
+		loader_info->minApiVersion > XR_CURRENT_API_VERSION)
+	{
+		return XR_ERROR_INITIALIZATION_FAILED;
+	}
+
+	runtime_request->runtimeInterfaceVersion = loader::XR_CURRENT_LOADER_RUNTIME_VERSION;
+	runtime_request->runtimeApiVersion = XR_CURRENT_API_VERSION;
+	runtime_request->getInstanceProcAddr = &mock_xrGetInstanceProcAddr;
+	return XR_SUCCESS;
+}
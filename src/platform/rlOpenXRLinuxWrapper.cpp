@@ -0,0 +1,267 @@
+#include "platform/rlOpenXRLinuxWrapper.h"
+
+#include <X11/Xlib.h>
+#include <GL/glx.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <time.h>
+
+#define XR_USE_PLATFORM_XLIB
+#define XR_USE_PLATFORM_EGL
+#define XR_USE_GRAPHICS_API_OPENGL
+#define XR_USE_TIMESPEC
+#include "openxr/openxr.h"
+#include "openxr/openxr_platform.h"
+
+#include <cassert>
+
+// Storage for the binding handed out by wrapped_XrGraphicsBindingFromCurrentContext()
+static XrGraphicsBindingOpenGLXlibKHR s_graphics_binding_xlib{ XR_TYPE_GRAPHICS_BINDING_OPENGL_XLIB_KHR };
+static XrGraphicsBindingEGLMNDX s_graphics_binding_egl{ XR_TYPE_GRAPHICS_BINDING_EGL_MNDX };
+
+// Headless context created by wrapped_eglCreateHeadlessContext()
+struct HeadlessEGLContext
+{
+	EGLDisplay display = EGL_NO_DISPLAY;
+	EGLSurface surface = EGL_NO_SURFACE;
+	EGLContext context = EGL_NO_CONTEXT;
+};
+static HeadlessEGLContext s_headless;
+
+static EGLDisplay headless_display()
+{
+	// Prefer Mesa's surfaceless platform, it does not need a DRM device or display server.
+	auto eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	if (eglGetPlatformDisplayEXT != nullptr)
+	{
+		EGLDisplay display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		if (display != EGL_NO_DISPLAY)
+		{
+			return display;
+		}
+	}
+
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+static const XrBaseInStructure* graphics_binding_xlib()
+{
+	Display* display = glXGetCurrentDisplay();
+	GLXContext context = glXGetCurrentContext();
+	GLXDrawable drawable = glXGetCurrentDrawable();
+	assert(display != nullptr && context != nullptr);
+
+	// The FBConfig of the current context is not directly queryable, look it up by id.
+	int fb_config_id = 0;
+	glXQueryContext(display, context, GLX_FBCONFIG_ID, &fb_config_id);
+
+	const int fb_config_attribs[] = { GLX_FBCONFIG_ID, fb_config_id, None };
+	int fb_config_count = 0;
+	GLXFBConfig* fb_configs = glXChooseFBConfig(display, DefaultScreen(display), fb_config_attribs, &fb_config_count);
+	if (fb_configs == nullptr || fb_config_count == 0)
+	{
+		return nullptr;
+	}
+
+	int visual_id = 0;
+	glXGetFBConfigAttrib(display, fb_configs[0], GLX_VISUAL_ID, &visual_id);
+
+	s_graphics_binding_xlib = XrGraphicsBindingOpenGLXlibKHR{
+		.type = XR_TYPE_GRAPHICS_BINDING_OPENGL_XLIB_KHR,
+		.next = nullptr,
+		.xDisplay = display,
+		.visualid = (uint32_t)visual_id,
+		.glxFBConfig = fb_configs[0],
+		.glxDrawable = drawable,
+		.glxContext = context
+	};
+
+	XFree(fb_configs);
+
+	return (const XrBaseInStructure*)&s_graphics_binding_xlib;
+}
+
+static const XrBaseInStructure* graphics_binding_egl()
+{
+	EGLDisplay display = eglGetCurrentDisplay();
+	EGLContext context = eglGetCurrentContext();
+	assert(display != EGL_NO_DISPLAY && context != EGL_NO_CONTEXT);
+
+	EGLint config_id = 0;
+	eglQueryContext(display, context, EGL_CONFIG_ID, &config_id);
+
+	const EGLint config_attribs[] = { EGL_CONFIG_ID, config_id, EGL_NONE };
+	EGLConfig config = nullptr;
+	EGLint config_count = 0;
+	if (!eglChooseConfig(display, config_attribs, &config, 1, &config_count) || config_count == 0)
+	{
+		return nullptr;
+	}
+
+	s_graphics_binding_egl = XrGraphicsBindingEGLMNDX{
+		.type = XR_TYPE_GRAPHICS_BINDING_EGL_MNDX,
+		.next = nullptr,
+		.getProcAddress = &eglGetProcAddress,
+		.display = display,
+		.config = config,
+		.context = context
+	};
+
+	return (const XrBaseInStructure*)&s_graphics_binding_egl;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+RLOpenXRLinuxGLBinding wrapped_GetCurrentGLBinding()
+{
+	if (glXGetCurrentContext() != nullptr)
+	{
+		return RLOPENXR_LINUX_GL_BINDING_XLIB;
+	}
+
+	if (eglGetCurrentContext() != EGL_NO_CONTEXT)
+	{
+		return RLOPENXR_LINUX_GL_BINDING_EGL;
+	}
+
+	return RLOPENXR_LINUX_GL_BINDING_NONE;
+}
+
+const XrBaseInStructure* wrapped_XrGraphicsBindingFromCurrentContext(RLOpenXRLinuxGLBinding binding)
+{
+	switch (binding)
+	{
+	case RLOPENXR_LINUX_GL_BINDING_XLIB: return graphics_binding_xlib();
+	case RLOPENXR_LINUX_GL_BINDING_EGL: return graphics_binding_egl();
+	default: return nullptr;
+	}
+}
+
+XrTime wrapped_XrTimeFromTimespecMonotonic(XrInstance instance, void* xrConvertTimespecTimeToTimeKHR_funcptr)
+{
+	timespec time_monotonic{};
+	const int success_clock = clock_gettime(CLOCK_MONOTONIC, &time_monotonic);
+	assert(success_clock == 0);
+
+	auto xrConvertTimespecTimeToTimeKHR = (PFN_xrConvertTimespecTimeToTimeKHR)xrConvertTimespecTimeToTimeKHR_funcptr;
+	XrTime time_xr = 0;
+	XrResult result_xr = xrConvertTimespecTimeToTimeKHR(instance, &time_monotonic, &time_xr);
+	assert(XR_SUCCEEDED(result_xr));
+
+	return time_xr;
+}
+
+void* wrapped_glGetProcAddress(const char* name)
+{
+	if (glXGetCurrentContext() != nullptr)
+	{
+		return (void*)glXGetProcAddressARB((const GLubyte*)name);
+	}
+
+	return (void*)eglGetProcAddress(name);
+}
+
+bool wrapped_eglCreateHeadlessContext(int width, int height)
+{
+	assert(s_headless.context == EGL_NO_CONTEXT && "Headless context is already created");
+
+	s_headless.display = headless_display();
+	if (s_headless.display == EGL_NO_DISPLAY)
+	{
+		return false;
+	}
+
+	if (!eglInitialize(s_headless.display, nullptr, nullptr))
+	{
+		wrapped_eglDestroyHeadlessContext();
+		return false;
+	}
+
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		wrapped_eglDestroyHeadlessContext();
+		return false;
+	}
+
+	const EGLint config_attribs[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_ALPHA_SIZE, 8,
+		EGL_DEPTH_SIZE, 24,
+		EGL_NONE
+	};
+	EGLConfig config = nullptr;
+	EGLint config_count = 0;
+	if (!eglChooseConfig(s_headless.display, config_attribs, &config, 1, &config_count) || config_count == 0)
+	{
+		wrapped_eglDestroyHeadlessContext();
+		return false;
+	}
+
+	// The pbuffer acts as the default framebuffer, so rlOpenXRBlitToWindow() works unchanged.
+	const EGLint pbuffer_attribs[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+	s_headless.surface = eglCreatePbufferSurface(s_headless.display, config, pbuffer_attribs);
+	if (s_headless.surface == EGL_NO_SURFACE)
+	{
+		wrapped_eglDestroyHeadlessContext();
+		return false;
+	}
+
+	// Same version raylib requests for GRAPHICS_API_OPENGL_33
+	const EGLint context_attribs[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 3,
+		EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	s_headless.context = eglCreateContext(s_headless.display, config, EGL_NO_CONTEXT, context_attribs);
+	if (s_headless.context == EGL_NO_CONTEXT)
+	{
+		wrapped_eglDestroyHeadlessContext();
+		return false;
+	}
+
+	if (!eglMakeCurrent(s_headless.display, s_headless.surface, s_headless.surface, s_headless.context))
+	{
+		wrapped_eglDestroyHeadlessContext();
+		return false;
+	}
+
+	return true;
+}
+
+void wrapped_eglDestroyHeadlessContext()
+{
+	if (s_headless.display == EGL_NO_DISPLAY)
+	{
+		return;
+	}
+
+	eglMakeCurrent(s_headless.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+	if (s_headless.context != EGL_NO_CONTEXT)
+	{
+		eglDestroyContext(s_headless.display, s_headless.context);
+	}
+	if (s_headless.surface != EGL_NO_SURFACE)
+	{
+		eglDestroySurface(s_headless.display, s_headless.surface);
+	}
+
+	eglTerminate(s_headless.display);
+	s_headless = HeadlessEGLContext{};
+}
+
+void* wrapped_eglGetProcAddress(const char* name)
+{
+	return (void*)eglGetProcAddress(name);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -28,6 +28,11 @@ BOOL wrapped_wglMakeCurrent(HDC hDC, HGLRC hGLRC)
 	return wglMakeCurrent(hDC, hGLRC);
 }
 
+void* wrapped_glGetProcAddress(const char* name)
+{
+	return (void*)wglGetProcAddress(name);
+}
+
 XrTime wrapped_XrTimeFromQueryPerformanceCounter(XrInstance instance, void* xrConvertWin32PerformanceCounterToTimeKHR_funcptr)
 {
 	LARGE_INTEGER time_win32{};
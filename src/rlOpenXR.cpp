@@ -1,7 +1,15 @@
 #include "rlOpenXR.h"
 
+#if defined(RLOPENXR_PLATFORM_WIN32)
 #include "platform/rlOpenXRWin32Wrapper.h"
 #define XR_USE_PLATFORM_WIN32
+#elif defined(RLOPENXR_PLATFORM_LINUX)
+#include "platform/rlOpenXRLinuxWrapper.h"
+#include <time.h>
+#define XR_USE_TIMESPEC
+#else
+#error "rlOpenXR: Unsupported platform, expected RLOPENXR_PLATFORM_WIN32 or RLOPENXR_PLATFORM_LINUX to be defined by CMake"
+#endif
 #define XR_USE_GRAPHICS_API_OPENGL
 #include "openxr/openxr.h"
 #include "openxr/openxr_platform.h"
@@ -11,12 +19,43 @@
 #include "raymath.h"
 #include "rlgl.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <cstdarg>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define RLOPENXR_SSE
+#endif
+
+// Most verbose level compiled in, set by the RLOPENXR_LOG_LEVEL CMake cache variable
+#ifndef RLOPENXR_LOG_LEVEL
+#define RLOPENXR_LOG_LEVEL RLOPENXR_LOG_LEVEL_INFO
+#endif
+
+// Messages above RLOPENXR_LOG_LEVEL are compiled out, including their arguments
+#define RLOPENXR_LOG(level, ...) do { if constexpr ((level) <= RLOPENXR_LOG_LEVEL) { log_message((level), __VA_ARGS__); } } while (false)
+#define RLOPENXR_LOG_ERROR(...) RLOPENXR_LOG(RLOPENXR_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define RLOPENXR_LOG_WARNING(...) RLOPENXR_LOG(RLOPENXR_LOG_LEVEL_WARNING, __VA_ARGS__)
+#define RLOPENXR_LOG_INFO(...) RLOPENXR_LOG(RLOPENXR_LOG_LEVEL_INFO, __VA_ARGS__)
+#define RLOPENXR_LOG_DEBUG(...) RLOPENXR_LOG(RLOPENXR_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
 
 // Types
 // ============================================================================
@@ -48,28 +87,61 @@ public:
 	}
 };
 
-struct RLExtraHandData
+// Lets the path table look up a const char* without building a std::string
+struct RLOpenXRStringHash
+{
+	using is_transparent = void;
+
+	size_t operator()(std::string_view string) const { return std::hash<std::string_view>{}(string); }
+};
+
+// GL_OVR_multiview, not loaded by raylib's glad
+typedef void (*PFN_glFramebufferTextureMultiviewOVR)(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint baseViewIndex, GLsizei numViews);
+
+// Controller model decoded from glTF on the loader thread, see controller_model_decode().
+// Owns the CPU side data until controller_model_begin_upload() hands it to a raylib Model.
+struct RLOpenXRControllerModelData
 {
 	// Data
-	cgltf_data* controller_model = nullptr;
+	XrControllerModelKeyMSFT key = XR_NULL_CONTROLLER_MODEL_KEY_MSFT;
+	std::vector<Mesh> meshes; // Arrays are allocated with MemAlloc(), so UnloadModel() can free them once they belong to a Model
+	std::vector<int> mesh_materials;
+	std::vector<Color> colors; // Base color factor per material
+	std::vector<Image> images; // Base color texture per material, data is nullptr without one
 
 	// Construction & Deconstruction
-	RLExtraHandData() = default;
-	~RLExtraHandData()
+	RLOpenXRControllerModelData() = default;
+	~RLOpenXRControllerModelData()
 	{
-		cgltf_free(controller_model);
+		// Not uploaded, so only the CPU side exists. UnloadMesh() would touch GL.
+		for (Mesh& mesh : meshes)
+		{
+			MemFree(mesh.vertices);
+			MemFree(mesh.texcoords);
+			MemFree(mesh.normals);
+			MemFree(mesh.indices);
+		}
+		for (Image& image : images)
+		{
+			UnloadImage(image);
+		}
 	}
 
 	// Move only
-	RLExtraHandData(const RLExtraHandData& other) = delete;
-	RLExtraHandData(RLExtraHandData&& other) noexcept
+	RLOpenXRControllerModelData(const RLOpenXRControllerModelData& other) = delete;
+	RLOpenXRControllerModelData(RLOpenXRControllerModelData&& other) noexcept
 	{
-		std::swap(controller_model, other.controller_model);
+		*this = std::move(other);
 	}
-	RLExtraHandData& operator=(const RLExtraHandData& other) = delete;
-	RLExtraHandData& operator=(RLExtraHandData&& other) noexcept
+	RLOpenXRControllerModelData& operator=(const RLOpenXRControllerModelData& other) = delete;
+	RLOpenXRControllerModelData& operator=(RLOpenXRControllerModelData&& other) noexcept
 	{
-		std::swap(controller_model, other.controller_model);
+		std::swap(key, other.key);
+		std::swap(meshes, other.meshes);
+		std::swap(mesh_materials, other.mesh_materials);
+		std::swap(colors, other.colors);
+		std::swap(images, other.images);
+		return *this;
 	}
 };
 
@@ -85,20 +157,476 @@ constexpr XrFormFactor c_form_factor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
 constexpr XrReferenceSpaceType c_play_space_type = XR_REFERENCE_SPACE_TYPE_STAGE;
 
 
+
+// Motion vectors are signed NDC deltas, XR_FB_space_warp expects a float format
+constexpr int64_t c_space_warp_motion_vector_format = GL_RGBA16F;
+
+// Dynamic resolution controller, see RLOPENXR_FLAG_DYNAMIC_RESOLUTION
+constexpr float c_dynamic_resolution_target = 0.85f;   // Fraction of the display period the GPU frame time aims for
+constexpr float c_dynamic_resolution_smoothing = 0.2f; // Fraction of the correction applied per new GPU sample, GPU samples lag a few frames
+
+// Number of frames rlOpenXRGetFrameStats() reports over
+constexpr int c_frame_stats_window = 300;
+
+// Frames of GPU timer queries in flight, results are read back this many frames later so reading never stalls
+constexpr int c_gpu_timer_frame_count = 4;
+
+// Float actions are pressed above this value, see RLOpenXRActionState
+constexpr float c_action_press_threshold = 0.5f;
+
+// Subaction paths of per hand actions, indexed by RLOpenXRHandEnum
+constexpr std::array<const char*, RLOPENXR_HAND_COUNT> c_hand_paths{ "/user/hand/left", "/user/hand/right" };
+
+// Space locations remembered per frame, see locate_space_cached()
+constexpr int c_pose_cache_size = 32;
+
+// Meshes or textures of a controller model uploaded per rlOpenXRUpdate(), see controller_models_update()
+constexpr int c_controller_model_uploads_per_frame = 1;
+
+// Log messages that can wait for the log thread, longer messages are truncated
+constexpr uint32_t c_log_queue_capacity = 256;
+constexpr size_t c_log_message_size = 512;
+constexpr auto c_log_flush_interval = std::chrono::milliseconds(10);
+
+// Runtime events rlOpenXRPollEvent() can fall behind on, a power of 2 so the ring indices can wrap
+constexpr uint32_t c_event_queue_capacity = 64;
+
+// Set in RLOpenXRFrameWaiter::consumed to tell the wait thread to exit.
+constexpr uint64_t c_frame_waiter_stop_bit = 1ull << 63;
+
+// Replaces rlgl's default shader with RLOPENXR_FLAG_MULTIVIEW.
+// rlgl hands it a mono MVP, rlOpenXRProjectionInverse undoes the projection it was built with and
+// rlOpenXRViewCorrection takes the head relative position to each eye's clip space.
+constexpr const char* c_multiview_vertex_shader = R"(#version 330
+#extension GL_OVR_multiview2 : require
+layout(num_views = 2) in;
+
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec4 vertexColor;
+
+uniform mat4 mvp;
+uniform mat4 rlOpenXRProjectionInverse;
+uniform mat4 rlOpenXRViewCorrection[2];
+
+out vec2 fragTexCoord;
+out vec4 fragColor;
+
+void main()
+{
+	fragTexCoord = vertexTexCoord;
+	fragColor = vertexColor;
+	gl_Position = rlOpenXRViewCorrection[gl_ViewID_OVR] * rlOpenXRProjectionInverse * mvp * vec4(vertexPosition, 1.0);
+}
+)";
+
+// Same as rlgl's default fragment shader, used by the multiview and instanced stereo shaders
+constexpr const char* c_default_fragment_shader = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+out vec4 finalColor;
+
+void main()
+{
+	vec4 texelColor = texture(texture0, fragTexCoord);
+	finalColor = texelColor * colDiffuse * fragColor;
+}
+)";
+
+// Replaces rlgl's default shader in rlOpenXRDrawMesh() for rlgl's side by side stereo mode.
+// The mesh is drawn with 2 instances, the instance id picks the eye and moves it into its half of the framebuffer.
+constexpr const char* c_instanced_stereo_vertex_shader = R"(#version 330
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec4 vertexColor;
+
+uniform mat4 rlOpenXREyeMvp[2];
+
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out float gl_ClipDistance[2];
+
+void main()
+{
+	fragTexCoord = vertexTexCoord;
+	fragColor = vertexColor;
+
+	vec4 position = rlOpenXREyeMvp[gl_InstanceID] * vec4(vertexPosition, 1.0);
+
+	// Clip against the eye's own frustum, the viewport covers both halves
+	gl_ClipDistance[0] = position.w + position.x;
+	gl_ClipDistance[1] = position.w - position.x;
+
+	float half_offset = (gl_InstanceID == 0) ? -0.5 : 0.5;
+	gl_Position = vec4(position.x * 0.5 + half_offset * position.w, position.yzw);
+}
+)";
+
+// Full screen triangle per view for RLOPENXR_FLAG_SPACE_WARP, generated from gl_VertexID without vertex buffers.
+// rlOpenXRDepthRect is the view's part of the eye depth image in texture coordinates.
+constexpr const char* c_space_warp_vertex_shader = R"(#version 330
+uniform vec4 rlOpenXRDepthRect;
+
+out vec2 depthTexCoord;
+out vec2 ndc;
+
+void main()
+{
+	vec2 uv = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	depthTexCoord = rlOpenXRDepthRect.xy + uv * rlOpenXRDepthRect.zw;
+	ndc = uv * 2.0 - 1.0;
+	gl_Position = vec4(ndc, 0.0, 1.0);
+}
+)";
+
+// Velocity of the scene relative to the previous frame, from the eye depth and the change in view projection.
+// Everything is assumed static, so only head motion produces motion vectors.
+// Compiled with RLOPENXR_MULTIVIEW defined for layered eye depth, see shader_source().
+constexpr const char* c_space_warp_fragment_shader = R"(#version 330
+#ifdef RLOPENXR_MULTIVIEW
+uniform sampler2DArray rlOpenXRDepth;
+uniform int rlOpenXRDepthLayer;
+#else
+uniform sampler2D rlOpenXRDepth;
+#endif
+uniform mat4 rlOpenXRReprojection; // Previous view projection * inverse(current view projection)
+
+in vec2 depthTexCoord;
+in vec2 ndc;
+
+out vec4 motionVector;
+
+void main()
+{
+#ifdef RLOPENXR_MULTIVIEW
+	float depth = texture(rlOpenXRDepth, vec3(depthTexCoord, float(rlOpenXRDepthLayer))).r;
+#else
+	float depth = texture(rlOpenXRDepth, depthTexCoord).r;
+#endif
+
+	vec4 current = vec4(ndc, depth * 2.0 - 1.0, 1.0);
+	vec4 previous = rlOpenXRReprojection * current;
+
+	motionVector = vec4(current.xyz - previous.xyz / previous.w, 0.0);
+	gl_FragDepth = depth;
+}
+)";
+
+// Size of the offscreen default framebuffer in headless mode, rlOpenXRBlitToWindow() copies into this.
+constexpr int c_headless_framebuffer_width = 1280;
+constexpr int c_headless_framebuffer_height = 720;
+
+
 // State
 // ============================================================================
 
+// Set before rlOpenXRSetup(), so it lives outside of RLOpenXRAllData
+struct RLOpenXRConfig
+{
+	unsigned int flags = 0;
+	std::string frame_stats_dump_path; // Written in rlOpenXRShutdown(), see rlOpenXRSetFrameStatsDumpPath()
+
+	// Relative to recommendedImageRect, see rlOpenXRSetResolutionScaleRange()
+	float resolution_scale_min = 0.5f;
+	float resolution_scale_max = 1.0f;
+
+	// GL internal formats in order of preference, see rlOpenXRSetSwapchainColorFormats()
+	std::vector<int64_t> color_formats{ GL_SRGB8_ALPHA8 };
+	std::vector<int64_t> depth_formats{ GL_DEPTH_COMPONENT16 };
+
+	std::string controller_model_cache_dir; // Empty disables the cache, see rlOpenXRSetControllerModelCacheDir()
+
+	int idle_sleep_ms = 100; // Per rlOpenXRUpdate() without a running session, see rlOpenXRSetIdleSleep()
+};
+
+static RLOpenXRConfig s_config;
+
+struct RLOpenXRLogSlot
+{
+	std::atomic<uint32_t> sequence{ 0 }; // == write index + 1 once the message is written, see log_message_v()
+	RLOpenXRLogLevel level = RLOPENXR_LOG_LEVEL_NONE;
+	char message[c_log_message_size];
+};
+
+// Bounded multi producer ring, the runtime's debug messages can come from any thread. 
+// Messages are formatted by the caller and written by `thread`, so a slow console or log file never blocks the frame loop.
+// The thread runs between rlOpenXRSetup() and rlOpenXRShutdown(), outside of that messages are written directly.
+struct RLOpenXRLog
+{
+	std::array<RLOpenXRLogSlot, c_log_queue_capacity> slots;
+	std::atomic<uint32_t> write{ 0 };
+	uint32_t read = 0; // Only used by the thread that drains the ring
+	std::atomic<uint32_t> dropped{ 0 }; // Messages that did not fit since the last drain
+
+	std::atomic<int> level{ RLOPENXR_LOG_LEVEL }; // See rlOpenXRSetLogLevel()
+	std::atomic<bool> to_trace_log{ false };      // See rlOpenXRSetLogToTraceLog()
+
+	std::thread thread;
+	std::atomic<bool> running{ false };
+
+	// Construction & Deconstruction
+	RLOpenXRLog()
+	{
+		for (uint32_t i = 0; i < c_log_queue_capacity; ++i)
+		{
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+	~RLOpenXRLog()
+	{
+		// Apps can return from main() without calling rlOpenXRShutdown()
+		running.store(false, std::memory_order_release);
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+};
+
+static RLOpenXRLog s_log;
+
 struct RLOpenXRDataExtensions
 {
 	// Required extensions
 	PFN_xrGetOpenGLGraphicsRequirementsKHR xrGetOpenGLGraphicsRequirementsKHR = nullptr;
+#if defined(RLOPENXR_PLATFORM_WIN32)
 	PFN_xrConvertWin32PerformanceCounterToTimeKHR xrConvertWin32PerformanceCounterToTimeKHR = nullptr;
+#elif defined(RLOPENXR_PLATFORM_LINUX)
+	PFN_xrConvertTimespecTimeToTimeKHR xrConvertTimespecTimeToTimeKHR = nullptr;
+#endif
 
 	// Optional extensions
 	PFN_xrCreateDebugUtilsMessengerEXT xrCreateDebugUtilsMessengerEXT = nullptr;
+	PFN_xrDestroyDebugUtilsMessengerEXT xrDestroyDebugUtilsMessengerEXT = nullptr;
 	XrDebugUtilsMessengerEXT debug_messenger_handle = XR_NULL_HANDLE;
 
 	bool depth_enabled = false;
+
+#ifdef XR_KHR_locate_spaces
+	PFN_xrLocateSpacesKHR xrLocateSpacesKHR = nullptr; // nullptr when the runtime does not support it
+#endif
+
+	bool hand_tracking_enabled = false; // XR_EXT_hand_tracking, the system can still lack support, see hand_trackers
+	PFN_xrCreateHandTrackerEXT xrCreateHandTrackerEXT = nullptr;
+	PFN_xrDestroyHandTrackerEXT xrDestroyHandTrackerEXT = nullptr;
+	PFN_xrLocateHandJointsEXT xrLocateHandJointsEXT = nullptr;
+
+	bool space_warp_enabled = false; // XR_FB_space_warp, only with RLOPENXR_FLAG_SPACE_WARP. See RLOpenXRSpaceWarp
+
+	bool cylinder_enabled = false; // XR_KHR_composition_layer_cylinder
+	bool equirect2_enabled = false; // XR_KHR_composition_layer_equirect2
+
+	bool controller_model_enabled = false; // XR_MSFT_controller_model, see rlOpenXRGetControllerModel()
+	PFN_xrGetControllerModelKeyMSFT xrGetControllerModelKeyMSFT = nullptr;
+	PFN_xrLoadControllerModelMSFT xrLoadControllerModelMSFT = nullptr;
+
+	// GL extensions
+	PFN_glFramebufferTextureMultiviewOVR glFramebufferTextureMultiviewOVR = nullptr;
+};
+
+// Owns xrWaitFrame() on a separate thread, see RLOPENXR_FLAG_PIPELINED_WAIT_FRAME.
+// Single slot handoff: the thread only writes `slot` when published == consumed, the main thread only reads it when published > consumed.
+struct RLOpenXRFrameWaiter
+{
+	std::thread thread;
+	std::atomic<uint64_t> published{ 0 }; // Frames waited on by the thread
+	std::atomic<uint64_t> consumed{ 0 };  // Frames taken by the main thread, | c_frame_waiter_stop_bit to stop the thread
+
+	XrFrameState slot{ XR_TYPE_FRAME_STATE };
+	XrResult slot_result = XR_SUCCESS;
+	int64_t slot_wait_ns = 0; // Time the thread was blocked in xrWaitFrame()
+};
+
+// One frame of pacing data for rlOpenXRGetFrameStats()
+struct RLOpenXRFrameRecord
+{
+	XrTime predicted_display_time = 0;
+	XrDuration predicted_display_period = 0;
+	XrDuration display_time_delta = 0; // predicted_display_time - the previous frame's
+	bool has_display_time_delta = false; // false for the first frame
+	int64_t wait_ns = 0;
+	int64_t begin_to_end_ns = 0;
+	bool should_render = false;
+};
+
+struct RLOpenXRFrameStatsHistory
+{
+	std::array<RLOpenXRFrameRecord, c_frame_stats_window> records; // Ring buffer
+	int count = 0;
+	int next = 0;
+
+	RLOpenXRFrameRecord pending; // Current frame, committed when the next frame state arrives
+	bool has_pending = false;
+	int64_t begin_time_ns = 0;
+};
+
+// GPU timestamp queries of one frame, see rlOpenXRGetGpuTimings()
+struct RLOpenXRGpuTimerFrame
+{
+	unsigned int begin_query = 0;
+	unsigned int end_query = 0;
+	std::array<unsigned int, RLOPENXR_MAX_GPU_ZONES> zone_begin_queries{};
+	std::array<unsigned int, RLOPENXR_MAX_GPU_ZONES> zone_end_queries{};
+	std::array<RLOpenXRGpuZone, RLOPENXR_MAX_GPU_ZONES> zones{}; // name & depth, gpu_ms is filled on read back
+	std::array<bool, RLOPENXR_MAX_GPU_ZONES> zone_ended{};
+	int zone_count = 0;
+	bool pending = false; // Queries were issued, but the results are not read yet
+};
+
+struct RLOpenXRGpuTimers
+{
+	std::array<RLOpenXRGpuTimerFrame, c_gpu_timer_frame_count> frames;
+	uint64_t frame_index = 0;
+	RLOpenXRGpuTimerFrame* recording = nullptr; // Between rlOpenXRBegin() and rlOpenXREnd()
+
+	std::array<int, RLOPENXR_MAX_GPU_ZONES> open_zones{}; // Stack of zone indices in `recording`
+	int open_zone_count = 0;
+
+	RLOpenXRGpuTimings latest{}; // Last frame that was read back
+	uint64_t read_back_count = 0;
+};
+
+// xrLocateSpace() result, valid for the frame it was located in
+struct RLOpenXRPoseCacheEntry
+{
+	XrSpace space = XR_NULL_HANDLE;
+	XrSpace base_space = XR_NULL_HANDLE;
+	XrTime time = 0;
+	XrSpaceLocation location{ XR_TYPE_SPACE_LOCATION };
+};
+
+struct RLOpenXRPoseCache
+{
+	std::array<RLOpenXRPoseCacheEntry, c_pose_cache_size> entries;
+	int count = 0;
+	int next = 0; // Overwritten when full
+};
+
+// Interned XrPaths of this instance, see rlOpenXRPath()
+struct RLOpenXRPathTable
+{
+	std::unordered_map<std::string, XrPath, RLOpenXRStringHash, std::equal_to<>> paths;
+	std::unordered_map<XrPath, std::string> strings;
+};
+
+// Action manager, see rlOpenXRCreateActionSet()
+struct RLOpenXRManagedActionSet
+{
+	XrActionSet handle = XR_NULL_HANDLE;
+	bool active = true;
+};
+
+struct RLOpenXRManagedAction
+{
+	XrAction handle = XR_NULL_HANDLE;
+	XrActionType type = XR_ACTION_TYPE_BOOLEAN_INPUT;
+	int action_set = -1;
+	int subaction_count = 1; // 2 for per hand actions
+	int state_offset = 0;    // Into RLOpenXRActionManager::states
+	Two<XrSpace> spaces{};   // Pose actions only
+};
+
+struct RLOpenXRActionManager
+{
+	std::vector<RLOpenXRManagedActionSet> sets;
+	std::vector<RLOpenXRManagedAction> actions;
+	std::vector<RLOpenXRActionState> states; // Flat, action.state_offset + subaction. Refreshed every rlOpenXRUpdate()
+	std::vector<std::pair<XrPath, XrActionSuggestedBinding>> suggested_bindings; // Per interaction profile, submitted in rlOpenXRAttachActionSets()
+	std::vector<XrActiveActionSet> active_sets; // Scratch space for xrSyncActions()
+	Two<XrPath> hand_paths{};
+	bool attached = false;
+};
+
+// Runtime events for rlOpenXRPollEvent(). Single producer (rlOpenXRUpdate()) and single consumer (rlOpenXRPollEvent()),
+// so apps can read events on another thread. Nothing is allocated or printed after setup.
+struct RLOpenXREventQueue
+{
+	std::array<RLOpenXREvent, c_event_queue_capacity> events{};
+	std::atomic<uint32_t> head{ 0 };    // Next event to write, only written by the producer
+	std::atomic<uint32_t> tail{ 0 };    // Next event to read, only written by the consumer
+	std::atomic<uint32_t> dropped{ 0 }; // Events that did not fit, reported as RLOPENXR_EVENT_EVENTS_LOST
+
+	// Events of a type with a callback are not queued, see rlOpenXRSetEventCallback()
+	std::array<RLOpenXREventCallback, RLOPENXR_EVENT_TYPE_COUNT> callbacks{};
+	std::array<void*, RLOPENXR_EVENT_TYPE_COUNT> callback_user_data{};
+};
+
+static_assert((c_event_queue_capacity & (c_event_queue_capacity - 1)) == 0, "Ring indices wrap around at UINT32_MAX");
+
+// Loads and decodes controller models on a separate thread, see rlOpenXRGetControllerModel().
+// Requests and results are handed over under `mutex`, the thread never touches GL.
+struct RLOpenXRControllerModelLoader
+{
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool stop = false;
+	std::vector<XrControllerModelKeyMSFT> requests;
+	std::vector<RLOpenXRControllerModelData> results; // Without meshes when loading failed
+};
+
+struct RLOpenXRControllerModel
+{
+	XrControllerModelKeyMSFT key = XR_NULL_CONTROLLER_MODEL_KEY_MSFT;
+	RLOpenXRControllerModelData decoded; // Moves into `model` while it's uploaded
+	Model model{}; // Allocated when the upload starts
+	int uploaded_meshes = 0;
+	int uploaded_materials = 0;
+	bool ready = false; // Fully uploaded, `model` can be drawn. Models that failed to load are never ready
+};
+
+// Application SpaceWarp, see RLOPENXR_FLAG_SPACE_WARP.
+// rlOpenXREnd() renders motion vectors and their depth from the eye depth into their own swapchains, and chains `infos` onto the projection views.
+struct RLOpenXRSpaceWarp
+{
+	bool loaded = false; // Swapchains and shader are created, see space_warp_load()
+	bool active = false; // Submitted with the projection views, see rlOpenXRSetSpaceWarpActive()
+
+	XrExtent2Di view_extent{}; // Per view, XrSystemSpaceWarpPropertiesFB::recommendedMotionVectorImageRect*
+	XrSwapchain motion_vector_swapchain = XR_NULL_HANDLE;
+	std::vector<XrSwapchainImageOpenGLKHR> motion_vector_images;
+	XrSwapchain depth_swapchain = XR_NULL_HANDLE;
+	std::vector<XrSwapchainImageOpenGLKHR> depth_images;
+
+	unsigned int fbo = 0; // Images are attached every frame, there is only one pass per frame
+	unsigned int vao = 0; // Empty, core profile needs one bound to draw
+	Shader shader{};
+	int depth_rect_loc = -1;
+	int depth_layer_loc = -1;
+	int reprojection_loc = -1;
+
+	Two<Matrix> previous_view_projections{}; // Of the last submitted frame, per view
+	bool has_previous = false;
+
+	std::vector<XrCompositionLayerSpaceWarpInfoFB> infos; // Per view, chained to projection_views
+};
+
+// Composition layer next to layer_projection, see rlOpenXRCreateQuadLayer(), rlOpenXRCreateCylinderLayer() and rlOpenXRCreateEquirectLayer()
+struct RLOpenXRLayer
+{
+	XrSwapchain swapchain = XR_NULL_HANDLE; // XR_NULL_HANDLE for unused slots
+	std::vector<XrSwapchainImageOpenGLKHR> swapchain_images;
+	std::vector<unsigned int> fbos; // Per swapchain image
+	int width = 0;
+	int height = 0;
+
+	union // `header.type` tells which one is active
+	{
+		XrCompositionLayerBaseHeader header;
+		XrCompositionLayerQuad quad{ XR_TYPE_COMPOSITION_LAYER_QUAD };
+		XrCompositionLayerCylinderKHR cylinder;
+		XrCompositionLayerEquirect2KHR equirect2;
+	};
+
+	bool visible = true;
+	bool dirty = true;      // Redrawn by the next rlOpenXRBeginLayer()
+	bool has_image = false; // An image was released, the compositor keeps showing the last one
+	bool static_image = false; // XR_SWAPCHAIN_CREATE_STATIC_IMAGE_BIT, can only be drawn once
+	bool background = false; // Submitted before layer_projection
 };
 
 struct RLOpenXRAllData
@@ -112,31 +640,89 @@ struct RLOpenXRAllData
 
 	RLOpenXRDataExtensions extensions;
 
-	// TODO: Support more than windows
-	XrGraphicsBindingOpenGLWin32KHR graphics_binding_gl;
+#if defined(RLOPENXR_PLATFORM_LINUX)
+	RLOpenXRLinuxGLBinding linux_gl_binding = RLOPENXR_LINUX_GL_BINDING_NONE;
+#endif
 
 	XrFrameState frame_state{ XR_TYPE_FRAME_STATE };
 
 	bool session_running = false; // to avoid beginning an already running session
 	bool run_framecycle = false;  // for some session states skip the frame cycle
+	bool frame_begun = false;     // xrBeginFrame() succeeded, rlOpenXREnd() has to end the frame
+	bool frame_rendered = false;  // Swapchain images are acquired and rendered into, rlOpenXREnd() submits them
+
+	RLOpenXRFrameWaiter frame_waiter;
+	bool pipelined_frame_acquired = false; // frame_state was taken from frame_waiter, and not begun yet
+
+	RLOpenXRFrameStatsHistory frame_stats;
+	RLOpenXRGpuTimers gpu_timers;
+
+	RLOpenXREventQueue event_queue;
+
+	RLOpenXRPathTable path_table;
+	RLOpenXRActionManager action_manager;
+
+	Two<XrHandTrackerEXT> hand_trackers{ XR_NULL_HANDLE, XR_NULL_HANDLE }; // Indexed by RLOpenXRHandEnum, null without hand tracking
+
+	RLOpenXRControllerModelLoader controller_model_loader;
+	std::vector<RLOpenXRControllerModel> controller_models; // Every key seen in this session, switching back to a controller does not load it again
+	Two<XrControllerModelKeyMSFT> controller_model_keys{ XR_NULL_CONTROLLER_MODEL_KEY_MSFT, XR_NULL_CONTROLLER_MODEL_KEY_MSFT }; // Per hand
+	bool controller_model_keys_dirty = false; // Set when the interaction profile changes
+
+	// Frame scoped, cleared by invalidate_frame_cache()
+	RLOpenXRPoseCache pose_cache;
+	XrTime frame_time = 0; // rlOpenXRGetTime() of this frame, 0 until it's asked for
+
+#ifdef XR_KHR_locate_spaces
+	std::vector<XrSpaceLocationDataKHR> space_locations; // Scratch space for rlOpenXRLocateSpaces()
+#endif
+
+	XrExtent2Di swapchain_view_extent{}; // Area per view allocated in the swapchains, views are rendered at resolution_scale within it
+	float resolution_scale = 1.f;
+	uint64_t resolution_scale_gpu_sample = 0; // gpu_timers.read_back_count the scale was last updated from
 
 	std::vector<XrViewConfigurationView> viewconfig_views; // array of view_count configuration view, contain information like resolution about each view
 	std::vector<XrCompositionLayerProjectionView> projection_views; // array of view_count containers for submitting swapchains with rendered VR frames
 	std::vector<XrCompositionLayerDepthInfoKHR> depth_infos; // extends projection_views
+	RLOpenXRSpaceWarp space_warp; // extends projection_views
 	
 	XrCompositionLayerProjection layer_projection{ XR_TYPE_COMPOSITION_LAYER_PROJECTION }; // Composition layer of all the views
-	std::vector<XrCompositionLayerBaseHeader*> layers_pointers; // Composition layers (Will point to `layer_projection`)
+	std::vector<XrCompositionLayerBaseHeader*> layers_pointers; // Composition layers, `layer_projection` and the visible `layers`. See update_layers_pointers()
+	std::vector<RLOpenXRLayer> layers; // See rlOpenXRCreateQuadLayer()
+	int active_layer = -1; // Between rlOpenXRBeginLayer() and rlOpenXREndLayer()
+	uint32_t max_layer_count = 1; // XrSystemGraphicsProperties::maxLayerCount
 	std::vector<XrView> views; // array of view_count views, filled by the runtime with current HMD display pose
 
+	int64_t color_format = 0; // Negotiated in rlOpenXRSetup()
+	int64_t depth_format = 0; // 0 when depth is disabled
+
 	XrSwapchain swapchain = XR_NULL_HANDLE;
 	std::vector<XrSwapchainImageOpenGLKHR> swapchain_images;
 	XrSwapchain depth_swapchain = XR_NULL_HANDLE;
 	std::vector<XrSwapchainImageOpenGLKHR> depth_swapchain_images;
 
-	unsigned int fbo = 0;
+	std::vector<unsigned int> swapchain_fbos; // Per (color image, depth image) pair, see swapchain_fbo_index()
+	unsigned int fbo = 0; // Of the acquired swapchain images
+	uint32_t color_image_index = 0; // Acquired color swapchain image
+	uint32_t depth_image_index = 0; // Acquired depth swapchain image, when depth is enabled
 	RenderTexture mock_hmd_rt{0};
 	unsigned int active_fbo = 0;
 
+	bool headless = false; // rlOpenXR owns the GL context, see RLOPENXR_FLAG_HEADLESS
+
+	// Multiview, see RLOPENXR_FLAG_MULTIVIEW
+	bool multiview = false; // The flag is set and GL_OVR_multiview2 is supported, swapchains have a layer per view
+	Shader multiview_shader{};
+	Two<int> multiview_correction_locs{ -1, -1 };
+	int multiview_projection_inverse_loc = -1;
+	Matrix multiview_projection{}; // rlOpenXRProjectionInverse is the inverse of this
+	std::vector<Two<unsigned int>> multiview_blit_fbos; // Read framebuffer per color swapchain image and layer, for rlOpenXRBlitToWindow()
+	Shader instanced_stereo_shader{}; // id is 0 when it failed to load, or multiview is used
+	Two<int> instanced_stereo_mvp_locs{ -1, -1 };
+
+	float camera_fovy = 45.f; // Of the camera last passed to rlOpenXRUpdateCamera(), the multiview shader undoes its projection for rlgl's batched draws
+	int camera_projection = CAMERA_PERSPECTIVE;
+
 	// Construction & Deconstruction
 	RLOpenXRAllData() = default;
 	~RLOpenXRAllData() = default;
@@ -154,6 +740,131 @@ static std::unique_ptr<RLOpenXRAllData> s_xr;
 // Helpers
 //=============================================================================
 
+// Logging
+static void log_write(RLOpenXRLogLevel level, const char* message)
+{
+	if (s_log.to_trace_log.load(std::memory_order_relaxed))
+	{
+		constexpr std::array<int, 5> trace_log_levels{ LOG_NONE, LOG_ERROR, LOG_WARNING, LOG_INFO, LOG_DEBUG };
+		TraceLog(trace_log_levels[level], "XR: %s", message);
+	}
+	else
+	{
+		FILE* stream = level == RLOPENXR_LOG_LEVEL_ERROR ? stderr : stdout;
+		fputs(message, stream);
+		fputc('\n', stream);
+	}
+}
+
+static void log_message_v(RLOpenXRLogLevel level, const char* format, va_list args)
+{
+	if (level > s_log.level.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	if (!s_log.running.load(std::memory_order_acquire))
+	{
+		char message[c_log_message_size];
+		vsnprintf(message, sizeof(message), format, args);
+		log_write(level, message);
+		return;
+	}
+
+	// Claim a slot, it's free when its sequence caught up with the write index
+	uint32_t write = s_log.write.load(std::memory_order_relaxed);
+	RLOpenXRLogSlot* slot = nullptr;
+	while (true)
+	{
+		slot = &s_log.slots[write % c_log_queue_capacity];
+		const int32_t distance = (int32_t)(slot->sequence.load(std::memory_order_acquire) - write);
+		if (distance == 0)
+		{
+			if (s_log.write.compare_exchange_weak(write, write + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (distance < 0)
+		{
+			s_log.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+		{
+			write = s_log.write.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->level = level;
+	vsnprintf(slot->message, sizeof(slot->message), format, args);
+	slot->sequence.store(write + 1, std::memory_order_release);
+}
+
+static void log_message(RLOpenXRLogLevel level, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	log_message_v(level, format, args);
+	va_end(args);
+}
+
+static void log_drain()
+{
+	while (true)
+	{
+		RLOpenXRLogSlot& slot = s_log.slots[s_log.read % c_log_queue_capacity];
+		if (slot.sequence.load(std::memory_order_acquire) != s_log.read + 1)
+		{
+			break;
+		}
+
+		log_write(slot.level, slot.message);
+		slot.sequence.store(s_log.read + c_log_queue_capacity, std::memory_order_release);
+		++s_log.read;
+	}
+
+	const uint32_t dropped = s_log.dropped.exchange(0, std::memory_order_relaxed);
+	if (dropped > 0)
+	{
+		char message[64];
+		snprintf(message, sizeof(message), "%u log messages were dropped", dropped);
+		log_write(RLOPENXR_LOG_LEVEL_WARNING, message);
+	}
+}
+
+static void log_thread()
+{
+	while (s_log.running.load(std::memory_order_acquire))
+	{
+		log_drain();
+		std::this_thread::sleep_for(c_log_flush_interval);
+	}
+	log_drain();
+}
+
+static void start_log_thread()
+{
+	if (s_log.thread.joinable())
+	{
+		return;
+	}
+
+	s_log.running.store(true, std::memory_order_release);
+	s_log.thread = std::thread(&log_thread);
+}
+
+static void stop_log_thread()
+{
+	if (!s_log.thread.joinable())
+	{
+		return;
+	}
+
+	s_log.running.store(false, std::memory_order_release);
+	s_log.thread.join();
+}
+
 static bool xr_check(XrResult result, const char* format, ...)
 {
 	if (XR_SUCCEEDED(result))
@@ -169,14 +880,17 @@ static bool xr_check(XrResult result, const char* format, ...)
 		snprintf(resultString, XR_MAX_RESULT_STRING_SIZE, "Error XrResult(%d)", result);
 	}
 
-	char formatRes[XR_MAX_RESULT_STRING_SIZE + 1024];
-	snprintf(formatRes, XR_MAX_RESULT_STRING_SIZE + 1023, "%s [%s] (%d)\n", format, resultString,
-		result);
-
-	va_list args;
-	va_start(args, format);
-	vprintf(formatRes, args);
-	va_end(args);
+	if constexpr (RLOPENXR_LOG_LEVEL_ERROR <= RLOPENXR_LOG_LEVEL)
+	{
+		char formatRes[XR_MAX_RESULT_STRING_SIZE + 1024];
+		snprintf(formatRes, XR_MAX_RESULT_STRING_SIZE + 1023, "%s [%s] (%d)", format, resultString,
+			result);
+
+		va_list args;
+		va_start(args, format);
+		log_message_v(RLOPENXR_LOG_LEVEL_ERROR, formatRes, args);
+		va_end(args);
+	}
 
 	return false;
 }
@@ -194,34 +908,34 @@ static void print_instance_properties(XrInstance instance)
 	if (!xr_check(result, "Failed to get instance info"))
 		return;
 
-	printf("Runtime Name: %s\n", instance_props.runtimeName);
-	printf("Runtime Version: %d.%d.%d\n", XR_VERSION_MAJOR(instance_props.runtimeVersion),
+	RLOPENXR_LOG_INFO("Runtime Name: %s", instance_props.runtimeName);
+	RLOPENXR_LOG_INFO("Runtime Version: %d.%d.%d", XR_VERSION_MAJOR(instance_props.runtimeVersion),
 		XR_VERSION_MINOR(instance_props.runtimeVersion),
 		XR_VERSION_PATCH(instance_props.runtimeVersion));
 }
 
 static void print_system_properties(XrSystemProperties* system_properties)
 {
-	printf("System properties for system %llu: \"%s\", vendor ID %d\n", system_properties->systemId,
+	RLOPENXR_LOG_INFO("System properties for system %llu: \"%s\", vendor ID %d", (unsigned long long)system_properties->systemId,
 		system_properties->systemName, system_properties->vendorId);
-	printf("\tMax layers          : %d\n", system_properties->graphicsProperties.maxLayerCount);
-	printf("\tMax swapchain height: %d\n",
+	RLOPENXR_LOG_INFO("\tMax layers          : %d", system_properties->graphicsProperties.maxLayerCount);
+	RLOPENXR_LOG_INFO("\tMax swapchain height: %d",
 		system_properties->graphicsProperties.maxSwapchainImageHeight);
-	printf("\tMax swapchain width : %d\n",
+	RLOPENXR_LOG_INFO("\tMax swapchain width : %d",
 		system_properties->graphicsProperties.maxSwapchainImageWidth);
-	printf("\tOrientation Tracking: %d\n", system_properties->trackingProperties.orientationTracking);
-	printf("\tPosition Tracking   : %d\n", system_properties->trackingProperties.positionTracking);
+	RLOPENXR_LOG_INFO("\tOrientation Tracking: %d", system_properties->trackingProperties.orientationTracking);
+	RLOPENXR_LOG_INFO("\tPosition Tracking   : %d", system_properties->trackingProperties.positionTracking);
 }
 
 static void print_viewconfig_view_info(uint32_t view_count, XrViewConfigurationView* viewconfig_views)
 {
 	for (uint32_t i = 0; i < view_count; i++) {
-		printf("View Configuration View %d:\n", i);
-		printf("\tResolution       : Recommended %dx%d, Max: %dx%d\n",
+		RLOPENXR_LOG_INFO("View Configuration View %d:", i);
+		RLOPENXR_LOG_INFO("\tResolution       : Recommended %dx%d, Max: %dx%d",
 			viewconfig_views[0].recommendedImageRectWidth,
 			viewconfig_views[0].recommendedImageRectHeight, viewconfig_views[0].maxImageRectWidth,
 			viewconfig_views[0].maxImageRectHeight);
-		printf("\tSwapchain Samples: Recommended: %d, Max: %d)\n",
+		RLOPENXR_LOG_INFO("\tSwapchain Samples: Recommended: %d, Max: %d)",
 			viewconfig_views[0].recommendedSwapchainSampleCount,
 			viewconfig_views[0].maxSwapchainSampleCount);
 	}
@@ -280,995 +994,4284 @@ static Matrix xr_matrix(const XrPosef& pose)
 static XrPosef identity_pose = { .orientation = {.x = 0, .y = 0, .z = 0, .w = 1.0},
 								.position = {.x = 0, .y = 0, .z = 0} };
 
-// Temp thingy
-static XrBool32 my_xrDebugUtilsMessengerCallback(
+// Runtime messages go through the log, they can arrive on any thread
+static XrBool32 debug_messenger_callback(
 	XrDebugUtilsMessageSeverityFlagsEXT              messageSeverity,
-	XrDebugUtilsMessageTypeFlagsEXT                  messageTypes,
+	XrDebugUtilsMessageTypeFlagsEXT                  /*messageTypes*/,
 	const XrDebugUtilsMessengerCallbackDataEXT* callbackData,
-	void* userData)
+	void* /*userData*/)
 {
-	printf("xrDebugUtilsMessengerCallback: %s\n", callbackData->message);
-	int i = 3;
+	if (messageSeverity & XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+		RLOPENXR_LOG_ERROR("Runtime: %s", callbackData->message);
+	else if (messageSeverity & XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
+		RLOPENXR_LOG_WARNING("Runtime: %s", callbackData->message);
+	else if (messageSeverity & XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)
+		RLOPENXR_LOG_INFO("Runtime: %s", callbackData->message);
+	else
+		RLOPENXR_LOG_DEBUG("Runtime: %s", callbackData->message);
 
 	return XR_FALSE;
 }
 
+// The runtime only sends messages the log would keep
+static XrDebugUtilsMessageSeverityFlagsEXT debug_messenger_severities()
+{
+	const int level = std::min<int>(RLOPENXR_LOG_LEVEL, s_log.level.load(std::memory_order_relaxed));
+
+	XrDebugUtilsMessageSeverityFlagsEXT severities = 0;
+	if (level >= RLOPENXR_LOG_LEVEL_ERROR) severities |= XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+	if (level >= RLOPENXR_LOG_LEVEL_WARNING) severities |= XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+	if (level >= RLOPENXR_LOG_LEVEL_INFO) severities |= XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+	if (level >= RLOPENXR_LOG_LEVEL_DEBUG) severities |= XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
+	return severities;
+}
 
-// Functions
-// ============================================================================
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-bool rlOpenXRSetup()
+// Frame stats
+static int64_t steady_time_ns()
 {
-	assert(s_xr == nullptr);
-	s_xr = std::make_unique<RLOpenXRAllData>();
-
-	XrResult result = XR_SUCCESS;
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
-	//print_api_layers();
+// Called when a new frame state arrives from xrWaitFrame()
+static void frame_stats_record_wait(const XrFrameState& frame_state, int64_t wait_ns)
+{
+	auto& stats = s_xr->frame_stats;
 
-	// xrEnumerate*() functions are usually called once with CapacityInput = 0.
-	// The function will write the required amount into CountOutput. We then have
-	// to allocate an array to hold CountOutput elements and call the function
-	// with CountOutput as CapacityInput.
-	uint32_t ext_count = 0;
-	result = xrEnumerateInstanceExtensionProperties(NULL, 0, &ext_count, NULL);
-	if (XR_FAILED(result))
+	XrTime previous_display_time = 0;
+	if (stats.has_pending)
 	{
-		printf("Failed to enumerate number of extension properties. error code: %d\n", result);
-		return false;
+		previous_display_time = stats.pending.predicted_display_time;
+
+		stats.records[stats.next] = stats.pending;
+		stats.next = (stats.next + 1) % c_frame_stats_window;
+		stats.count = std::min(stats.count + 1, c_frame_stats_window);
 	}
 
-	std::vector<XrExtensionProperties> ext_props{ ext_count, { XR_TYPE_EXTENSION_PROPERTIES } };
+	stats.pending = RLOpenXRFrameRecord{
+		.predicted_display_time = frame_state.predictedDisplayTime,
+		.predicted_display_period = frame_state.predictedDisplayPeriod,
+		.display_time_delta = previous_display_time != 0 ? frame_state.predictedDisplayTime - previous_display_time : 0,
+		.has_display_time_delta = previous_display_time != 0,
+		.wait_ns = wait_ns,
+		.begin_to_end_ns = 0,
+		.should_render = frame_state.shouldRender == XR_TRUE
+	};
+	stats.has_pending = true;
+}
 
-	result = xrEnumerateInstanceExtensionProperties(NULL, ext_count, &ext_count, &ext_props[0]);
-	if (XR_FAILED(result))
+template<typename F>
+static void frame_stats_for_each(F&& function)
+{
+	const auto& stats = s_xr->frame_stats;
+	const int first = (stats.next - stats.count + c_frame_stats_window) % c_frame_stats_window;
+	for (int i = 0; i < stats.count; ++i)
 	{
-		printf("Failed to enumerate number of extension properties. error code: %d\n", result);
-		return false;
+		function(stats.records[(first + i) % c_frame_stats_window]);
 	}
+}
 
-	bool opengl_supported = false;
-	std::vector enabled_exts{ XR_KHR_OPENGL_ENABLE_EXTENSION_NAME, XR_EXT_DEBUG_UTILS_EXTENSION_NAME, XR_KHR_WIN32_CONVERT_PERFORMANCE_COUNTER_TIME_EXTENSION_NAME };
-
-	printf("Runtime supports %d extensions\n", ext_count);
-	for (uint32_t i = 0; i < ext_count; i++) {
-		printf("\t%s v%d\n", ext_props[i].extensionName, ext_props[i].extensionVersion);
-
-		if (strcmp(XR_KHR_OPENGL_ENABLE_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
-			opengl_supported = true;
-		}
-
-		if (strcmp(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
-			s_xr->extensions.depth_enabled = true;
-			enabled_exts.push_back(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME);
-		}
-
-		if (strcmp(XR_MSFT_CONTROLLER_MODEL_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
-			enabled_exts.push_back(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME);
-		}
+static void frame_stats_accumulate(RLOpenXRStat& stat, double value_ms, int sample_index)
+{
+	const float value = (float)value_ms;
+	if (sample_index == 0)
+	{
+		stat = RLOpenXRStat{ value, value, value };
+		return;
 	}
 
-	if (!opengl_supported) 
+	stat.min = std::min(stat.min, value);
+	stat.max = std::max(stat.max, value);
+	stat.avg += (value - stat.avg) / (float)(sample_index + 1); // Running mean
+}
+
+static void frame_stats_dump(const char* path)
+{
+	FILE* file = fopen(path, "w");
+	if (file == nullptr)
 	{
-		printf("Runtime does not support OpenGL extension!\n");
-		return false;
+		RLOPENXR_LOG_ERROR("rlOpenXR could not open '%s' to write frame stats.", path);
+		return;
 	}
 
-	// --- Create XrInstance
-	// same can be done for API layers, but API layers can also be enabled by env var
+	const size_t path_length = strlen(path);
+	const bool json = path_length >= 5 && strcmp(path + path_length - 5, ".json") == 0;
 
-	XrInstanceCreateInfo instance_create_info = {
-		.type = XR_TYPE_INSTANCE_CREATE_INFO,
-		.next = NULL,
-		.createFlags = 0,
-		.applicationInfo = {
-			.applicationVersion = 1,
-			.engineVersion = 0,
-			.apiVersion = XR_CURRENT_API_VERSION,
-		},
-		.enabledApiLayerCount = 0,
-		.enabledApiLayerNames = NULL,
-		.enabledExtensionCount = (uint32_t)enabled_exts.size(),
-		.enabledExtensionNames = enabled_exts.data(),
-	};
-	strcpy_s(instance_create_info.applicationInfo.applicationName, "rlOpenXR Application"); // TODO: Do we want this to be exposed? Does it have any purpose?
-	strcpy_s(instance_create_info.applicationInfo.engineName, "Raylib (rlOpenXR)");
+	if (json)
+	{
+		RLOpenXRFrameStats summary;
+		rlOpenXRGetFrameStats(&summary);
 
-	result = xrCreateInstance(&instance_create_info, &s_xr->data.instance);
-	if (!xr_check(result, "Failed to create XR instance."))
-		return false;
+		const auto print_stat = [file](const char* name, const RLOpenXRStat& stat) {
+			fprintf(file, "\t\t\"%s\": { \"min\": %.4f, \"avg\": %.4f, \"max\": %.4f },\n", name, stat.min, stat.avg, stat.max);
+		};
 
-	result = xrGetInstanceProcAddr(s_xr->data.instance, "xrGetOpenGLGraphicsRequirementsKHR",
-			(PFN_xrVoidFunction*)&s_xr->extensions.xrGetOpenGLGraphicsRequirementsKHR);
-	if (!xr_check(result, "Failed to get OpenGL graphics requirements function!"))
-		return false;
+		fprintf(file, "{\n\t\"summary\": {\n");
+		fprintf(file, "\t\t\"frame_count\": %d,\n", summary.frame_count);
+		print_stat("display_period_ms", summary.display_period_ms);
+		print_stat("display_time_delta_ms", summary.display_time_delta_ms);
+		print_stat("wait_frame_ms", summary.wait_frame_ms);
+		print_stat("begin_to_end_ms", summary.begin_to_end_ms);
+		fprintf(file, "\t\t\"dropped_frames\": %d,\n", summary.dropped_frames);
+		fprintf(file, "\t\t\"repeated_frames\": %d,\n", summary.repeated_frames);
+		fprintf(file, "\t\t\"should_render_ratio\": %.4f\n", summary.should_render_ratio);
+		fprintf(file, "\t},\n\t\"frames\": [\n");
+
+		int index = 0;
+		frame_stats_for_each([&](const RLOpenXRFrameRecord& record) {
+			fprintf(file, "\t\t{ \"predicted_display_time\": %lld, \"display_period_ns\": %lld, \"display_time_delta_ns\": %lld, \"wait_ns\": %lld, \"begin_to_end_ns\": %lld, \"should_render\": %s }%s\n",
+				(long long)record.predicted_display_time, (long long)record.predicted_display_period, (long long)record.display_time_delta,
+				(long long)record.wait_ns, (long long)record.begin_to_end_ns, record.should_render ? "true" : "false",
+				++index < s_xr->frame_stats.count ? "," : "");
+		});
+		fprintf(file, "\t]\n}\n");
+	}
+	else
+	{
+		fprintf(file, "predicted_display_time,display_period_ns,display_time_delta_ns,wait_ns,begin_to_end_ns,should_render\n");
+		frame_stats_for_each([file](const RLOpenXRFrameRecord& record) {
+			fprintf(file, "%lld,%lld,%lld,%lld,%lld,%d\n",
+				(long long)record.predicted_display_time, (long long)record.predicted_display_period, (long long)record.display_time_delta,
+				(long long)record.wait_ns, (long long)record.begin_to_end_ns, record.should_render ? 1 : 0);
+		});
+	}
 
-	result = xrGetInstanceProcAddr(s_xr->data.instance, "xrConvertWin32PerformanceCounterToTimeKHR",
-		(PFN_xrVoidFunction*)&s_xr->extensions.xrConvertWin32PerformanceCounterToTimeKHR);
-	if (!xr_check(result, "Failed to get xrConvertWin32PerformanceCounterToTimeKHR function!"))
-		return false;
+	fclose(file);
+	RLOPENXR_LOG_INFO("rlOpenXR wrote frame stats to '%s'", path);
+}
 
-	result = xrGetInstanceProcAddr(s_xr->data.instance, "xrCreateDebugUtilsMessengerEXT",
-			(PFN_xrVoidFunction*)&s_xr->extensions.xrCreateDebugUtilsMessengerEXT);
-	if (!xr_check(result, "Failed to get xrCreateDebugUtilsMessengerEXT function!"))
-		return false;
+// GPU timers
+static void gpu_timers_load()
+{
+	for (auto& frame : s_xr->gpu_timers.frames)
+	{
+		glGenQueries(1, &frame.begin_query);
+		glGenQueries(1, &frame.end_query);
+		glGenQueries(RLOPENXR_MAX_GPU_ZONES, frame.zone_begin_queries.data());
+		glGenQueries(RLOPENXR_MAX_GPU_ZONES, frame.zone_end_queries.data());
+	}
+}
 
-	XrDebugUtilsMessengerCreateInfoEXT debug_message_create_info{
-		.type = XR_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT,
-		.next = nullptr,
-		.messageSeverities = XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT,
-		.messageTypes = XR_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_CONFORMANCE_BIT_EXT,
-		.userCallback = &my_xrDebugUtilsMessengerCallback,
-		.userData = nullptr
-	};
+static void gpu_timers_unload()
+{
+	for (auto& frame : s_xr->gpu_timers.frames)
+	{
+		// Not loaded when setup failed before gpu_timers_load(), the GL functions may not even be loaded then
+		if (frame.begin_query == 0)
+		{
+			continue;
+		}
 
-	// TODO: Only enable on RLGL_ENABLE_OPENGL_DEBUG_CONTEXT
-	// TODO: This leaks the handle, should be destroyed too
-	result = s_xr->extensions.xrCreateDebugUtilsMessengerEXT(s_xr->data.instance, &debug_message_create_info, &s_xr->extensions.debug_messenger_handle);
-	if (!xr_check(result, "Failed create debug messenger!"))
-		return false;
+		glDeleteQueries(1, &frame.begin_query);
+		glDeleteQueries(1, &frame.end_query);
+		glDeleteQueries(RLOPENXR_MAX_GPU_ZONES, frame.zone_begin_queries.data());
+		glDeleteQueries(RLOPENXR_MAX_GPU_ZONES, frame.zone_end_queries.data());
+	}
+}
 
-	// Optionally get runtime name and version
-	print_instance_properties(s_xr->data.instance);
+static float gpu_query_elapsed_ms(unsigned int begin_query, unsigned int end_query)
+{
+	GLuint64 begin = 0, end = 0;
+	glGetQueryObjectui64v(begin_query, GL_QUERY_RESULT, &begin);
+	glGetQueryObjectui64v(end_query, GL_QUERY_RESULT, &end);
+	return (float)((double)(end - begin) * 1e-6);
+}
 
-	// --- Get XrSystemId
-	XrSystemGetInfo system_get_info = {
-		.type = XR_TYPE_SYSTEM_GET_INFO, .next = NULL, .formFactor = c_form_factor };
+static void gpu_timers_read_back(RLOpenXRGpuTimerFrame& frame)
+{
+	frame.pending = false;
 
-	result = xrGetSystem(s_xr->data.instance, &system_get_info, &s_xr->data.system_id);
-	if (!xr_check(result, "Failed to get system for HMD form factor."))
-		return false;
+	// The end query is issued last, if it's done so are the others. If it's not done yet, drop the frame rather than stall.
+	GLint available = GL_FALSE;
+	glGetQueryObjectiv(frame.end_query, GL_QUERY_RESULT_AVAILABLE, &available);
+	if (available == GL_FALSE)
+	{
+		return;
+	}
 
-	printf("Successfully got XrSystem with id %llu for HMD form factor\n", s_xr->data.system_id);
+	RLOpenXRGpuTimings& timings = s_xr->gpu_timers.latest;
+	s_xr->gpu_timers.read_back_count++;
+	timings.valid = true;
+	timings.frame_gpu_ms = gpu_query_elapsed_ms(frame.begin_query, frame.end_query);
+	timings.zone_count = 0;
 
+	for (int i = 0; i < frame.zone_count; ++i)
 	{
-		XrSystemProperties system_props = {
-			.type = XR_TYPE_SYSTEM_PROPERTIES,
-			.next = NULL,
-		};
-
-		result = xrGetSystemProperties(s_xr->data.instance, s_xr->data.system_id, &system_props);
-		if (!xr_check(result, "Failed to get System properties"))
-			return false;
+		if (!frame.zone_ended[i])
+		{
+			continue;
+		}
 
-		print_system_properties(&system_props);
+		RLOpenXRGpuZone& zone = timings.zones[timings.zone_count++];
+		zone = frame.zones[i];
+		zone.gpu_ms = gpu_query_elapsed_ms(frame.zone_begin_queries[i], frame.zone_end_queries[i]);
 	}
+}
 
-	uint32_t view_count;
-	result = xrEnumerateViewConfigurationViews(s_xr->data.instance, s_xr->data.system_id, c_view_type, 0, &view_count, NULL);
-	if (!xr_check(result, "Failed to get view configuration view count!"))
-		return 1;
-
-	s_xr->viewconfig_views.resize(view_count, XrViewConfigurationView{ .type = XR_TYPE_VIEW_CONFIGURATION_VIEW , .next = nullptr });
-	
-	result = xrEnumerateViewConfigurationViews(s_xr->data.instance, s_xr->data.system_id, c_view_type, view_count,
-		&view_count, &s_xr->viewconfig_views[0]);
-	if (!xr_check(result, "Failed to enumerate view configuration views!"))
-		return 1;
-	print_viewconfig_view_info(view_count, &s_xr->viewconfig_views[0]);
-
+static void gpu_timers_begin_frame()
+{
+	auto& timers = s_xr->gpu_timers;
+	auto& frame = timers.frames[timers.frame_index % c_gpu_timer_frame_count];
 
-	// this function pointer was loaded with xrGetInstanceProcAddr
-	// OpenXR requires checking graphics requirements before creating a session.
-	XrGraphicsRequirementsOpenGLKHR opengl_reqs = { .type = XR_TYPE_GRAPHICS_REQUIREMENTS_OPENGL_KHR,
-												   .next = NULL };
+	if (frame.pending)
+	{
+		gpu_timers_read_back(frame);
+	}
 
+	frame.zone_count = 0;
+	timers.open_zone_count = 0;
+	timers.recording = &frame;
 
-	result = s_xr->extensions.xrGetOpenGLGraphicsRequirementsKHR(s_xr->data.instance, s_xr->data.system_id, &opengl_reqs);
-	if (!xr_check(result, "Failed to get OpenGL graphics requirements!"))
-		return false;
+	rlDrawRenderBatchActive(); // Keep earlier draws out of this frame
+	glQueryCounter(frame.begin_query, GL_TIMESTAMP);
+}
 
-	auto min_major = XR_VERSION_MAJOR(opengl_reqs.minApiVersionSupported);
-	auto min_minor = XR_VERSION_MINOR(opengl_reqs.minApiVersionSupported);
-	auto min_patch = XR_VERSION_PATCH(opengl_reqs.minApiVersionSupported);
+static void gpu_timers_end_frame()
+{
+	auto& timers = s_xr->gpu_timers;
+	if (timers.recording == nullptr)
+	{
+		return;
+	}
 
-	auto max_major = XR_VERSION_MAJOR(opengl_reqs.maxApiVersionSupported);
-	auto max_minor = XR_VERSION_MINOR(opengl_reqs.maxApiVersionSupported);
-	auto max_patch = XR_VERSION_PATCH(opengl_reqs.maxApiVersionSupported);
+	if (timers.open_zone_count > 0)
+	{
+		RLOPENXR_LOG_WARNING("rlOpenXR: %d GPU zone(s) still open at rlOpenXREnd(), missing rlOpenXRGpuZoneEnd()?", timers.open_zone_count);
+	}
 
-	int major, minor;
-	glGetIntegerv(GL_MAJOR_VERSION, &major);
-	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	rlDrawRenderBatchActive();
+	glQueryCounter(timers.recording->end_query, GL_TIMESTAMP);
 
-	printf("OpenXR OpenGL requirements, min: %d.%d.%d, max: %d.%d.%d, got: %d.%d\n", 
-		min_major, min_minor, min_patch,
-		max_major, max_minor, max_patch,
-		major, minor
-		);
+	timers.recording->pending = true;
+	timers.recording = nullptr;
+	timers.frame_index++;
+}
 
-	// --- Create session
-	// Assume the calling thread is the one initialised by raylib
-	auto graphics_binding_gl = XrGraphicsBindingOpenGLWin32KHR{
-		.type = XR_TYPE_GRAPHICS_BINDING_OPENGL_WIN32_KHR,
-		.next = nullptr,
-		.hDC = wrapped_wglGetCurrentDC(),
-		.hGLRC = wrapped_wglGetCurrentContext()
+// Resolution
+static XrExtent2Di scaled_view_extent()
+{
+	const auto& view = s_xr->viewconfig_views[0];
+	return XrExtent2Di{
+		std::clamp((int32_t)lroundf(view.recommendedImageRectWidth * s_xr->resolution_scale), 1, s_xr->swapchain_view_extent.width),
+		std::clamp((int32_t)lroundf(view.recommendedImageRectHeight * s_xr->resolution_scale), 1, s_xr->swapchain_view_extent.height)
 	};
+}
 
-	assert(graphics_binding_gl.hDC != NULL);
-	assert(graphics_binding_gl.hGLRC != NULL);
-
-	XrSessionCreateInfo session_create_info = {
-		.type = XR_TYPE_SESSION_CREATE_INFO, .next = &graphics_binding_gl, .systemId = s_xr->data.system_id };
+// Views are packed left to right at the current resolution scale, this matches rlgl's stereo viewports.
+// With multiview every view has its own swapchain layer, so they all start at the origin.
+static void update_view_rects()
+{
+	const XrExtent2Di extent = scaled_view_extent();
+	for (size_t view = 0; view < s_xr->projection_views.size(); ++view)
+	{
+		const int32_t offset_x = s_xr->multiview ? 0 : (int32_t)view * extent.width;
+		const XrRect2Di rect{ { offset_x, 0 }, extent };
 
-	result = xrCreateSession(s_xr->data.instance, &session_create_info, &s_xr->data.session);
-	if (!xr_check(result, "Failed to create session"))
-		return 1;
+		s_xr->projection_views[view].subImage.imageRect = rect;
+		if (s_xr->extensions.depth_enabled)
+		{
+			s_xr->depth_infos[view].subImage.imageRect = rect;
+		}
+	}
+}
 
-	printf("Successfully created a session with OpenGL!\n");
+static void update_resolution_scale()
+{
+	const auto& timers = s_xr->gpu_timers;
+	if (!timers.latest.valid || timers.latest.frame_gpu_ms <= 0.f || timers.read_back_count == s_xr->resolution_scale_gpu_sample)
+	{
+		return;
+	}
+	s_xr->resolution_scale_gpu_sample = timers.read_back_count;
 
-	/* Many runtimes support at least STAGE and LOCAL but not all do.
-	 * Sophisticated apps might check with xrEnumerateReferenceSpaces() if the
-	 * chosen one is supported and try another one if not.
-	 * Here we will get an error from xrCreateReferenceSpace() and exit. */
-	XrReferenceSpaceCreateInfo play_space_create_info = { .type = XR_TYPE_REFERENCE_SPACE_CREATE_INFO,
-														 .next = NULL,
-														 .referenceSpaceType = c_play_space_type,
-														 .poseInReferenceSpace = identity_pose };
+	// GPU cost is roughly proportional to the pixel count, which is the scale squared
+	const float target_ms = (float)(s_xr->frame_state.predictedDisplayPeriod * 1e-6) * c_dynamic_resolution_target;
+	const float desired_scale = s_xr->resolution_scale * sqrtf(target_ms / timers.latest.frame_gpu_ms);
+	const float scale = s_xr->resolution_scale + (desired_scale - s_xr->resolution_scale) * c_dynamic_resolution_smoothing;
 
-	result = xrCreateReferenceSpace(s_xr->data.session, &play_space_create_info, &s_xr->data.play_space);
-	if (!xr_check(result, "Failed to create play space!"))
-		return false;
+	s_xr->resolution_scale = std::clamp(scale, s_config.resolution_scale_min, s_config.resolution_scale_max);
+}
 
-	XrReferenceSpaceCreateInfo view_space_create_info = { .type = XR_TYPE_REFERENCE_SPACE_CREATE_INFO,
-													 .next = NULL,
-													 .referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW,
-													 .poseInReferenceSpace = identity_pose };
+// Swapchain formats
+static const char* gl_format_name(int64_t format)
+{
+	switch (format)
+	{
+	case GL_SRGB8_ALPHA8: return "GL_SRGB8_ALPHA8";
+	case GL_RGBA8: return "GL_RGBA8";
+	case GL_RGB10_A2: return "GL_RGB10_A2";
+	case GL_R11F_G11F_B10F: return "GL_R11F_G11F_B10F";
+	case GL_RGBA16F: return "GL_RGBA16F";
+	case GL_DEPTH_COMPONENT16: return "GL_DEPTH_COMPONENT16";
+	case GL_DEPTH_COMPONENT24: return "GL_DEPTH_COMPONENT24";
+	case GL_DEPTH_COMPONENT32F: return "GL_DEPTH_COMPONENT32F";
+	case GL_DEPTH24_STENCIL8: return "GL_DEPTH24_STENCIL8";
+	case GL_DEPTH32F_STENCIL8: return "GL_DEPTH32F_STENCIL8";
+	default: return "Unknown GL format";
+	}
+}
 
-	result = xrCreateReferenceSpace(s_xr->data.session, &view_space_create_info, &s_xr->data.view_space);
-	if (!xr_check(result, "Failed to create view space!"))
-		return false;
+static bool gl_format_has_stencil(int64_t format)
+{
+	return format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+}
 
-	// --- Create Swapchains
-	uint32_t supported_gl_internal_format_count;
-	result = xrEnumerateSwapchainFormats(s_xr->data.session, 0, &supported_gl_internal_format_count, NULL);
-	if (!xr_check(result, "Failed to get number of supported swapchain formats"))
-		return false;
+// First format in `preferences` the runtime supports, 0 if there is none
+static int64_t negotiate_swapchain_format(const std::vector<int64_t>& preferences, const std::vector<int64_t>& supported)
+{
+	for (int64_t format : preferences)
+	{
+		if (std::find(supported.begin(), supported.end(), format) != supported.end())
+		{
+			return format;
+		}
+	}
+	return 0;
+}
 
-	printf("Runtime supports %d swapchain formats\n", supported_gl_internal_format_count);
+// Shaders
+// Inserts `defines` after the #version line of `source`
+static std::string shader_source(const char* source, const char* defines)
+{
+	const char* version_end = strchr(source, '\n');
+	assert(version_end != nullptr && "Shader sources start with a #version line");
 
-	std::vector<int64_t> supported_gl_internal_formats;
-	supported_gl_internal_formats.resize(supported_gl_internal_format_count);
-	result = xrEnumerateSwapchainFormats(s_xr->data.session, supported_gl_internal_format_count, &supported_gl_internal_format_count,
-		&supported_gl_internal_formats[0]);
-	if (!xr_check(result, "Failed to enumerate swapchain formats"))
-		return false;
+	return std::string(source, version_end + 1) + defines + (version_end + 1);
+}
 
-	uint32_t swapchain_width = 0;
-	for (uint32_t i = 0; i < view_count; i++)
+// Multiview
+static bool gl_extension_supported(const char* name)
+{
+	GLint extension_count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extension_count);
+	for (GLint i = 0; i < extension_count; ++i)
 	{
-		swapchain_width += s_xr->viewconfig_views[i].recommendedImageRectWidth;
-
-		// TODO: assert recommendedSwapchainSampleCounts & recommendedImageRectHeights are the same for each view
+		if (strcmp((const char*)glGetStringi(GL_EXTENSIONS, i), name) == 0)
+		{
+			return true;
+		}
 	}
+	return false;
+}
 
-	s_xr->fbo = rlLoadFramebuffer(swapchain_width, s_xr->viewconfig_views[0].recommendedImageRectHeight);
-	
-	// TODO: Better way to choose swapchain format than hardcoding it
-	const int color_gl_internal_format = GL_SRGB8_ALPHA8;
-	const auto color_format_name = "GL_SRGB8_ALPHA8";
-
-	if (std::find(supported_gl_internal_formats.begin(), supported_gl_internal_formats.end(), color_gl_internal_format)
-		== supported_gl_internal_formats.end())
+static bool multiview_load()
+{
+	if (!gl_extension_supported("GL_OVR_multiview2"))
 	{
-		printf("rlOpenXR render texture has color format '%s' which is not supported by this OpenXR driver.\n", color_format_name);
+		RLOPENXR_LOG_WARNING("rlOpenXR: GL_OVR_multiview2 is not supported, falling back to side by side stereo rendering.");
 		return false;
 	}
 
-	// TODO: Higher res depth buffer
-	int depth_gl_internal_format = GL_DEPTH_COMPONENT16;
-	const auto depth_format_name = "GL_DEPTH_COMPONENT16";
-	
-	if (std::find(supported_gl_internal_formats.begin(), supported_gl_internal_formats.end(), depth_gl_internal_format)
-		== supported_gl_internal_formats.end())
+	s_xr->extensions.glFramebufferTextureMultiviewOVR = (PFN_glFramebufferTextureMultiviewOVR)wrapped_glGetProcAddress("glFramebufferTextureMultiviewOVR");
+	if (s_xr->extensions.glFramebufferTextureMultiviewOVR == nullptr)
 	{
-		printf("rlOpenXR render texture has depth format '%s' which is not supported by this OpenXR driver. Disabling depth\n", depth_format_name);
-		s_xr->extensions.depth_enabled = false;
+		RLOPENXR_LOG_WARNING("rlOpenXR: Failed to load glFramebufferTextureMultiviewOVR, falling back to side by side stereo rendering.");
+		return false;
 	}
 
-	// --- Create swapchain for main VR rendering
+	// raylib hands out its default shader when compiling fails
+	Shader shader = LoadShaderFromMemory(c_multiview_vertex_shader, c_default_fragment_shader);
+	if (shader.id == rlGetShaderIdDefault())
 	{
-		// In the frame loop we render into OpenGL textures we receive from the runtime here.
-		XrSwapchainCreateInfo swapchain_create_info = {
-			.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
-			.next = NULL,
-			.createFlags = 0,
-			.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT,
-			.format = color_gl_internal_format,
-			//TODO: Get multisampling enabled from the Raylib hint
-			.sampleCount = s_xr->viewconfig_views[0].recommendedSwapchainSampleCount,
-			.width = swapchain_width,
-			.height = s_xr->viewconfig_views[0].recommendedImageRectHeight,
-			.faceCount = 1,
-			.arraySize = 1,
-			.mipCount = 1,
-		};
+		RLOPENXR_LOG_WARNING("rlOpenXR: Failed to compile the multiview shader, falling back to side by side stereo rendering.");
+		return false;
+	}
 
-		result = xrCreateSwapchain(s_xr->data.session, &swapchain_create_info, &s_xr->swapchain);
-		if (!xr_check(result, "Failed to create swapchain!"))
-			return 1;
+	s_xr->multiview_shader = shader;
+	s_xr->multiview_correction_locs = { 
+		GetShaderLocation(shader, "rlOpenXRViewCorrection[0]"), 
+		GetShaderLocation(shader, "rlOpenXRViewCorrection[1]") 
+	};
+	s_xr->multiview_projection_inverse_loc = GetShaderLocation(shader, "rlOpenXRProjectionInverse");
 
-		// The runtime controls how many textures we have to be able to render to
-		// (e.g. "triple buffering")
-		uint32_t swapchain_image_count;
-		result = xrEnumerateSwapchainImages(s_xr->swapchain, 0, &swapchain_image_count, NULL);
-		if (!xr_check(result, "Failed to enumerate swapchains"))
-			return false;
+	return true;
+}
 
-		s_xr->swapchain_images.resize(swapchain_image_count, { .type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR, .next = nullptr });
-		result = xrEnumerateSwapchainImages(s_xr->swapchain, swapchain_image_count, &swapchain_image_count,
-				(XrSwapchainImageBaseHeader*)s_xr->swapchain_images.data());
-		if (!xr_check(result, "Failed to enumerate swapchain images"))
-			return false;
+static void multiview_unload()
+{
+	if (!s_xr->multiview)
+	{
+		return;
+	}
 
-		printf("Succesfully created OpenXR color swapchain with format: %s. Dimensions: %d, %d\n", 
-			color_format_name, swapchain_create_info.width, swapchain_create_info.height);
+	UnloadShader(s_xr->multiview_shader);
+}
+
+// Swapchain framebuffers
+static void fbo_attach_swapchain_image(unsigned int fbo, unsigned int texture, GLenum attachment)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	if (s_xr->multiview)
+	{
+		// All layers at once, gl_ViewID_OVR selects the layer
+		s_xr->extensions.glFramebufferTextureMultiviewOVR(GL_FRAMEBUFFER, attachment, texture, 0, 0, c_view_count);
+	}
+	else
+	{
+		glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture, 0);
 	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
 
-	// --- Create swapchain for depth buffers if supported
+static size_t swapchain_fbo_index(uint32_t color_image_index, uint32_t depth_image_index)
+{
+	return (size_t)color_image_index * std::max<size_t>(s_xr->depth_swapchain_images.size(), 1) + depth_image_index;
+}
+
+// Color and depth images are acquired independently, so there is a framebuffer for every pair. 
+// rlOpenXRBegin() then only has to pick one, instead of re-attaching and re-validating every frame.
+static bool create_swapchain_framebuffers(uint32_t width, uint32_t height)
+{
+	const uint32_t color_image_count = (uint32_t)s_xr->swapchain_images.size();
+	const uint32_t depth_image_count = s_xr->extensions.depth_enabled ? (uint32_t)s_xr->depth_swapchain_images.size() : 0;
+	const GLenum depth_attachment = gl_format_has_stencil(s_xr->depth_format) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+
+	s_xr->swapchain_fbos.resize(color_image_count * std::max(depth_image_count, 1u));
+	for (uint32_t color_index = 0; color_index < color_image_count; ++color_index)
 	{
-		if (s_xr->extensions.depth_enabled) {
+		for (uint32_t depth_index = 0; depth_index < std::max(depth_image_count, 1u); ++depth_index)
+		{
+			const unsigned int fbo = rlLoadFramebuffer((int)width, (int)height);
+			s_xr->swapchain_fbos[swapchain_fbo_index(color_index, depth_index)] = fbo;
 
-			uint32_t depth_swapchain_width = 0;
-			for (uint32_t i = 0; i < view_count; i++)
+			fbo_attach_swapchain_image(fbo, s_xr->swapchain_images[color_index].image, GL_COLOR_ATTACHMENT0);
+			if (depth_image_count > 0)
 			{
-				depth_swapchain_width += s_xr->viewconfig_views[i].recommendedImageRectWidth;
+				fbo_attach_swapchain_image(fbo, s_xr->depth_swapchain_images[depth_index].image, depth_attachment);
+			}
 
-				// TODO: assert recommendedSwapchainSampleCounts & recommendedImageRectHeights are the same for each view
+			if (!rlFramebufferComplete(fbo))
+			{
+				RLOPENXR_LOG_ERROR("rlOpenXR swapchain framebuffer for color image %u and depth image %u is not complete.", color_index, depth_index);
+				return false;
 			}
+		}
+	}
 
-			XrSwapchainCreateInfo swapchain_create_info = {
-				.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
-				.next = NULL,
-				.createFlags = 0,
-				.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-				.format = depth_gl_internal_format,
-				.sampleCount = s_xr->viewconfig_views[0].recommendedSwapchainSampleCount,
-				.width = depth_swapchain_width,
-				.height = s_xr->viewconfig_views[0].recommendedImageRectHeight,
-				.faceCount = 1,
-				.arraySize = 1,
-				.mipCount = 1,
-			};
+	if (s_xr->multiview)
+	{
+		s_xr->multiview_blit_fbos.resize(color_image_count);
+		for (uint32_t color_index = 0; color_index < color_image_count; ++color_index)
+		{
+			auto& blit_fbos = s_xr->multiview_blit_fbos[color_index];
+			glCreateFramebuffers(c_view_count, blit_fbos.data());
+			for (int view = 0; view < c_view_count; ++view)
+			{
+				glNamedFramebufferTextureLayer(blit_fbos[view], GL_COLOR_ATTACHMENT0, s_xr->swapchain_images[color_index].image, 0, view);
+			}
+		}
+	}
 
-			result = xrCreateSwapchain(s_xr->data.session, &swapchain_create_info, &s_xr->depth_swapchain);
-			if (!xr_check(result, "Failed to create swapchain!"))
-				return false;
+	return true;
+}
 
-			uint32_t depth_swapchain_image_count;
-			result = xrEnumerateSwapchainImages(s_xr->depth_swapchain, 0, &depth_swapchain_image_count, NULL);
-			if (!xr_check(result, "Failed to enumerate swapchains"))
-				return false;
+// The eye color and depth images acquired and waited on in rlOpenXRBegin()
+static void release_swapchain_images()
+{
+	XrSwapchainImageReleaseInfo release_info{ XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
+	XrResult result = xrReleaseSwapchainImage(s_xr->swapchain, &release_info);
+	xr_check(result, "failed to release color swapchain image!");
 
-			// these are wrappers for the actual OpenGL texture id
-			s_xr->depth_swapchain_images.resize(depth_swapchain_image_count, {.type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR, .next = nullptr});
-			result = xrEnumerateSwapchainImages(s_xr->depth_swapchain, depth_swapchain_image_count, &depth_swapchain_image_count,
-				(XrSwapchainImageBaseHeader*)s_xr->depth_swapchain_images.data());
-			if (!xr_check(result, "Failed to enumerate swapchain images"))
-				return false;
+	if (s_xr->extensions.depth_enabled)
+	{
+		XrSwapchainImageReleaseInfo depth_release_info{ XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
+		result = xrReleaseSwapchainImage(s_xr->depth_swapchain, &depth_release_info);
+		xr_check(result, "failed to release depth swapchain image!");
+	}
+}
 
-			printf("Succesfully created OpenXR depth swapchain with format: %s. Dimensions: %d, %d\n",
-				depth_format_name, swapchain_create_info.width, swapchain_create_info.height);
-		}
+static void destroy_swapchain_framebuffers()
+{
+	for (unsigned int fbo : s_xr->swapchain_fbos)
+	{
+		rlUnloadFramebuffer(fbo);
 	}
+	s_xr->swapchain_fbos.clear();
 
+	for (auto& blit_fbos : s_xr->multiview_blit_fbos)
+	{
+		glDeleteFramebuffers(c_view_count, blit_fbos.data());
+	}
+	s_xr->multiview_blit_fbos.clear();
+}
 
-	// Do not allocate these every frame to save some resources
-	s_xr->views.resize(view_count, { .type = XR_TYPE_VIEW, .next = nullptr });
+// The projection BeginMode3D() builds for the camera passed to rlOpenXRUpdateCamera()
+static Matrix camera_projection_matrix(float aspect)
+{
+	if (s_xr->camera_projection == CAMERA_ORTHOGRAPHIC)
+	{
+		const double top = s_xr->camera_fovy / 2.0;
+		const double right = top * aspect;
+		return MatrixOrtho(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+	}
 
-	s_xr->projection_views.resize(view_count);
-	for (uint32_t view = 0; view < view_count; view++) {
-		s_xr->projection_views[view].type = XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW;
-		s_xr->projection_views[view].next = NULL;
+	return MatrixPerspective(s_xr->camera_fovy * DEG2RAD, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+}
 
-		s_xr->projection_views[view].subImage.swapchain = s_xr->swapchain;
-		s_xr->projection_views[view].subImage.imageArrayIndex = 0;
-		s_xr->projection_views[view].subImage.imageRect.offset.x = view * s_xr->viewconfig_views[view].recommendedImageRectWidth;
-		s_xr->projection_views[view].subImage.imageRect.offset.y = 0;
-		s_xr->projection_views[view].subImage.imageRect.extent.width = s_xr->viewconfig_views[view].recommendedImageRectWidth;
-		s_xr->projection_views[view].subImage.imageRect.extent.height = s_xr->viewconfig_views[view].recommendedImageRectHeight;
+// The camera renders from the head, so each view is corrected with: eye projection * inverse(eye relative to head).
+// The projection the draws were made with is undone separately, see multiview_set_projection().
+static Two<Matrix> multiview_corrections(const XrPosef& head_pose)
+{
+	const Matrix head = xr_matrix(head_pose);
 
-		// projection_views[i].{pose, fov} have to be filled every frame in frame loop
-	};
+	Two<Matrix> corrections;
+	for (int view = 0; view < c_view_count; ++view)
+	{
+		const Matrix eye_from_head = MatrixMultiply(head, MatrixInvert(xr_matrix(s_xr->views[view].pose)));
+		corrections[view] = MatrixMultiply(eye_from_head, xr_projection_matrix(s_xr->views[view].fov));
+	}
+	return corrections;
+}
 
+// Sets the projection the multiview shader undoes. It is a plain uniform, so rlgl's pending batch is drawn first with the previous one.
+static void multiview_set_projection(const Matrix& projection)
+{
+	if (memcmp(&projection, &s_xr->multiview_projection, sizeof(Matrix)) == 0)
+	{
+		return;
+	}
 
-	if (s_xr->extensions.depth_enabled) {
-		s_xr->depth_infos.resize(view_count);
-		for (uint32_t view = 0; view < view_count; view++) {
-			s_xr->depth_infos[view].type = XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR;
-			s_xr->depth_infos[view].next = NULL;
-			s_xr->depth_infos[view].minDepth = 0.f;
-			s_xr->depth_infos[view].maxDepth = 1.f;
-			s_xr->depth_infos[view].nearZ = (float)RL_CULL_DISTANCE_NEAR;
-			s_xr->depth_infos[view].farZ = (float)RL_CULL_DISTANCE_FAR;
+	rlDrawRenderBatchActive();
+	s_xr->multiview_projection = projection;
+	SetShaderValueMatrix(s_xr->multiview_shader, s_xr->multiview_projection_inverse_loc, MatrixInvert(projection));
+}
 
-			s_xr->depth_infos[view].subImage.swapchain = s_xr->depth_swapchain;
-			s_xr->depth_infos[view].subImage.imageArrayIndex = 0;
-			s_xr->depth_infos[view].subImage.imageRect.offset.x = view * s_xr->viewconfig_views[view].recommendedImageRectWidth;
-			s_xr->depth_infos[view].subImage.imageRect.offset.y = 0;
-			s_xr->depth_infos[view].subImage.imageRect.extent.width = s_xr->viewconfig_views[view].recommendedImageRectWidth;
-			s_xr->depth_infos[view].subImage.imageRect.extent.height = s_xr->viewconfig_views[view].recommendedImageRectHeight;
+// rlgl's stereo matrices for s_xr->views, indexed like rlGetMatrixProjectionStereo() and rlGetMatrixViewOffsetStereo()
+static void stereo_matrices(const XrPosef& head_pose, Two<Matrix>* projections, Two<Matrix>* view_offsets)
+{
+	auto proj_left = xr_projection_matrix(s_xr->views[0].fov);
+	auto proj_right = xr_projection_matrix(s_xr->views[1].fov);
+	std::swap(proj_left, proj_right); // For some reason it doesn't look right unless they are swapped!?
+	*projections = { proj_right, proj_left };
 
-			// depth is chained to projection, not submitted as separate layer
-			s_xr->projection_views[view].next = &s_xr->depth_infos[view];
-		};
+	const auto view_matrix = MatrixInvert(xr_matrix(head_pose));
+	const auto view_offset_left = MatrixMultiply(xr_matrix(s_xr->views[0].pose), view_matrix);
+	const auto view_offset_right = MatrixMultiply(xr_matrix(s_xr->views[1].pose), view_matrix);
+	*view_offsets = { view_offset_right, view_offset_left };
+}
+
+// Instanced stereo
+static void instanced_stereo_load()
+{
+	Shader shader = LoadShaderFromMemory(c_instanced_stereo_vertex_shader, c_default_fragment_shader);
+	if (shader.id == rlGetShaderIdDefault())
+	{
+		RLOPENXR_LOG_WARNING("rlOpenXR: Failed to compile the instanced stereo shader, rlOpenXRDrawMesh() draws each eye separately.");
+		return;
 	}
 
-	s_xr->layer_projection.layerFlags = 0;
-	s_xr->layer_projection.space = s_xr->data.play_space;
-	s_xr->layer_projection.viewCount = view_count;
-	s_xr->layer_projection.views = s_xr->projection_views.data();
-	s_xr->layers_pointers.push_back((XrCompositionLayerBaseHeader*)&s_xr->layer_projection);
+	s_xr->instanced_stereo_shader = shader;
+	s_xr->instanced_stereo_mvp_locs = { 
+		GetShaderLocation(shader, "rlOpenXREyeMvp[0]"), 
+		GetShaderLocation(shader, "rlOpenXREyeMvp[1]") 
+	};
+}
 
-	return true;
+static void instanced_stereo_unload()
+{
+	if (s_xr->instanced_stereo_shader.id != 0)
+	{
+		UnloadShader(s_xr->instanced_stereo_shader);
+	}
 }
 
-void rlOpenXRShutdown()
+// Same as raylib's DrawMesh() in rlgl's stereo mode for the default material shader, but with one draw call for both eyes.
+// Returns false without drawing for anything it can't reproduce, eg. a custom material shader, the caller falls back to DrawMesh() per eye.
+static bool draw_mesh_instanced_stereo(const Mesh& mesh, const Material& material, const Matrix& transform)
 {
-	if (!s_xr)
+	if (material.shader.id != rlGetShaderIdDefault() || s_xr->instanced_stereo_shader.id == 0 || mesh.vaoId == 0)
 	{
-		printf("%s", "rlOpenXR it not valid! Aborting openXR shutdown\n");
-		return;
+		return false;
 	}
 
-	rlUnloadFramebuffer(s_xr->fbo);
-	UnloadRenderTexture(s_xr->mock_hmd_rt);
+	const Shader& shader = s_xr->instanced_stereo_shader;
+	rlEnableShader(shader.id);
 
-	XrResult result = xrDestroyInstance(s_xr->data.instance);
-	if (XR_SUCCEEDED(result))
+	const Color color = material.maps[MATERIAL_MAP_DIFFUSE].color;
+	const float color_diffuse[4] = { color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f };
+	rlSetUniform(shader.locs[SHADER_LOC_COLOR_DIFFUSE], color_diffuse, SHADER_UNIFORM_VEC4, 1);
+
+	const Matrix model_view = MatrixMultiply(MatrixMultiply(transform, rlGetMatrixTransform()), rlGetMatrixModelview());
+	for (int eye = 0; eye < c_view_count; ++eye)
+	{
+		const Matrix mvp = MatrixMultiply(MatrixMultiply(model_view, rlGetMatrixViewOffsetStereo(eye)), rlGetMatrixProjectionStereo(eye));
+		rlSetUniformMatrix(s_xr->instanced_stereo_mvp_locs[eye], mvp);
+	}
+
+	// The default shader only samples the diffuse map
+	const unsigned int texture = material.maps[MATERIAL_MAP_DIFFUSE].texture.id;
+	const int texture_slot = 0;
+	rlActiveTextureSlot(texture_slot);
+	rlEnableTexture(texture != 0 ? texture : rlGetTextureIdDefault());
+	rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE], &texture_slot, SHADER_UNIFORM_INT, 1);
+
+	rlEnableVertexArray(mesh.vaoId);
+
+	// Like DrawMesh(), meshes without vertex colors are white
+	const int color_loc = shader.locs[SHADER_LOC_VERTEX_COLOR];
+	if (color_loc != -1 && mesh.vboId[3] == 0)
 	{
-		printf("%s", "Succesfully shutdown OpenXR.\n");
+		const float white[4] = { 1.f, 1.f, 1.f, 1.f };
+		rlSetVertexAttributeDefault(color_loc, white, SHADER_ATTRIB_VEC4, 4);
+		rlDisableVertexAttribute(color_loc);
+	}
+
+	glEnable(GL_CLIP_DISTANCE0);
+	glEnable(GL_CLIP_DISTANCE1);
+	if (mesh.indices != nullptr)
+	{
+		rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount * 3, 0, c_view_count);
 	}
 	else
 	{
-		printf("Failed to shutdown OpenXR. error code: %d\n", result);
+		rlDrawVertexArrayInstanced(0, mesh.vertexCount, c_view_count);
 	}
+	glDisable(GL_CLIP_DISTANCE0);
+	glDisable(GL_CLIP_DISTANCE1);
 
-	s_xr.reset();
-}
+	rlDisableTexture();
+	rlDisableVertexArray();
+	rlDisableShader();
 
-// ----------------------------------------------------------------------------
+	return true;
+}
 
-void rlOpenXRUpdate()
+// Same transform and tint as raylib's DrawModel(), with rlOpenXRDrawMesh()
+static void draw_model(const Model& model, const Matrix& transform, Color tint)
 {
-	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	const Matrix model_transform = MatrixMultiply(model.transform, transform);
 
-	XrResult result;
+	for (int i = 0; i < model.meshCount; ++i)
+	{
+		Material material = model.materials[model.meshMaterial[i]];
+		const Color color = material.maps[MATERIAL_MAP_DIFFUSE].color;
+
+		// The maps are shared with the model, so the tinted color is restored afterwards
+		material.maps[MATERIAL_MAP_DIFFUSE].color = Color{
+			(unsigned char)(color.r * tint.r / 255),
+			(unsigned char)(color.g * tint.g / 255),
+			(unsigned char)(color.b * tint.b / 255),
+			(unsigned char)(color.a * tint.a / 255)
+		};
+		rlOpenXRDrawMesh(model.meshes[i], material, model_transform);
+		material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+	}
+}
 
-	// Poll OpenXR Events
-	XrEventDataBuffer runtime_event = { .type = XR_TYPE_EVENT_DATA_BUFFER, .next = NULL };
-	XrResult poll_result = xrPollEvent(s_xr->data.instance, &runtime_event);
-	while (poll_result == XR_SUCCESS) {
-		switch (runtime_event.type) {
-		case XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING: {
-			XrEventDataInstanceLossPending* event = (XrEventDataInstanceLossPending*)&runtime_event;
-			printf("EVENT: instance loss pending at %llu! Destroying instance.\n", event->lossTime);
-			continue;
-		}
-		case XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED: {
-			XrEventDataSessionStateChanged* event = (XrEventDataSessionStateChanged*)&runtime_event;
-			printf("EVENT: session state changed from %d to %d\n", s_xr->data.session_state, event->state);
-			s_xr->data.session_state = event->state;
+// Application SpaceWarp
+static bool create_space_warp_swapchain(int64_t format, XrSwapchainUsageFlags usage, XrSwapchain* swapchain, std::vector<XrSwapchainImageOpenGLKHR>* images)
+{
+	const XrSwapchainCreateInfo swapchain_create_info = {
+		.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
+		.next = NULL,
+		.createFlags = 0,
+		.usageFlags = usage,
+		.format = format,
+		.sampleCount = 1,
+		.width = (uint32_t)s_xr->space_warp.view_extent.width * (s_xr->multiview ? 1 : c_view_count),
+		.height = (uint32_t)s_xr->space_warp.view_extent.height,
+		.faceCount = 1,
+		.arraySize = s_xr->multiview ? (uint32_t)c_view_count : 1,
+		.mipCount = 1,
+	};
 
-			/*
-			 * react to session state changes, see OpenXR spec 9.3 diagram. What we need to react to:
-			 *
-			 * * READY -> xrBeginSession STOPPING -> xrEndSession (note that the same session can be restarted)
-			 * * EXITING -> xrDestroySession (EXITING only happens after we went through STOPPING and called xrEndSession)
-			 *
-			 * After exiting it is still possible to create a new session but we don't do that here.
-			 *
-			 * * IDLE -> don't run render loop, but keep polling for events
-			 * * SYNCHRONIZED, VISIBLE, FOCUSED -> run render loop
-			 */
-			switch (s_xr->data.session_state) {
-				// skip render loop, keep polling
-			case XR_SESSION_STATE_MAX_ENUM: // must be a bug
-			case XR_SESSION_STATE_IDLE:
-			case XR_SESSION_STATE_UNKNOWN: {
-				s_xr->run_framecycle = false;
+	XrResult result = xrCreateSwapchain(s_xr->data.session, &swapchain_create_info, swapchain);
+	if (!xr_check(result, "Failed to create %s space warp swapchain", gl_format_name(format)))
+		return false;
 
-				break; // state handling switch
-			}
+	uint32_t image_count = 0;
+	result = xrEnumerateSwapchainImages(*swapchain, 0, &image_count, NULL);
+	if (!xr_check(result, "Failed to enumerate space warp swapchain images"))
+		return false;
 
-										 // do nothing, run render loop normally
-			case XR_SESSION_STATE_FOCUSED:
-			case XR_SESSION_STATE_SYNCHRONIZED:
-			case XR_SESSION_STATE_VISIBLE: {
-				s_xr->run_framecycle = true;
+	images->resize(image_count, { .type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR, .next = nullptr });
+	result = xrEnumerateSwapchainImages(*swapchain, image_count, &image_count, (XrSwapchainImageBaseHeader*)images->data());
+	return xr_check(result, "Failed to enumerate space warp swapchain images");
+}
 
-				break; // state handling switch
-			}
+// Motion vectors are rendered from the eye depth, so they need a single sampled depth swapchain
+static bool space_warp_load(const std::vector<int64_t>& supported_formats)
+{
+	auto& space_warp = s_xr->space_warp;
 
-										 // begin session and then run render loop
-			case XR_SESSION_STATE_READY: {
-				// start session only if it is not running, i.e. not when we already called xrBeginSession
-				// but the runtime did not switch to the next state yet
-				if (!s_xr->session_running) {
-					XrSessionBeginInfo session_begin_info = { .type = XR_TYPE_SESSION_BEGIN_INFO,
-															 .next = NULL,
-															 .primaryViewConfigurationType = c_view_type };
-					result = xrBeginSession(s_xr->data.session, &session_begin_info);
-					if (!xr_check(result, "Failed to begin session!"))
-						return;
-					printf("Session started!\n");
-					s_xr->session_running = true;
-				}
-				// after beginning the session, run render loop
-				s_xr->run_framecycle = true;
+	if (!s_xr->extensions.depth_enabled || s_xr->viewconfig_views[0].recommendedSwapchainSampleCount != 1)
+	{
+		RLOPENXR_LOG_WARNING("rlOpenXR: SpaceWarp needs a single sampled depth swapchain, disabling SpaceWarp.");
+		return false;
+	}
+	if (std::find(supported_formats.begin(), supported_formats.end(), c_space_warp_motion_vector_format) == supported_formats.end())
+	{
+		RLOPENXR_LOG_WARNING("rlOpenXR: %s is not a supported swapchain format, disabling SpaceWarp.", gl_format_name(c_space_warp_motion_vector_format));
+		return false;
+	}
 
-				break; // state handling switch
-			}
+	if (!create_space_warp_swapchain(c_space_warp_motion_vector_format, XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT, &space_warp.motion_vector_swapchain, &space_warp.motion_vector_images) ||
+		!create_space_warp_swapchain(s_xr->depth_format, XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, &space_warp.depth_swapchain, &space_warp.depth_images))
+	{
+		return false;
+	}
 
-									   // end session, skip render loop, keep polling for next state change
-			case XR_SESSION_STATE_STOPPING: {
-				// end session only if it is running, i.e. not when we already called xrEndSession but the
-				// runtime did not switch to the next state yet
-				if (s_xr->session_running) {
-					result = xrEndSession(s_xr->data.session);
-					if (!xr_check(result, "Failed to end session!"))
-						return;
-					s_xr->session_running = false;
-				}
-				// after ending the session, don't run render loop
-				s_xr->run_framecycle = false;
+	const std::string fragment_shader = shader_source(c_space_warp_fragment_shader, s_xr->multiview ? "#define RLOPENXR_MULTIVIEW\n" : "");
+	Shader shader = LoadShaderFromMemory(c_space_warp_vertex_shader, fragment_shader.c_str());
+	if (shader.id == rlGetShaderIdDefault())
+	{
+		RLOPENXR_LOG_WARNING("rlOpenXR: Failed to compile the SpaceWarp motion vector shader, disabling SpaceWarp.");
+		return false;
+	}
 
-				break; // state handling switch
+	space_warp.shader = shader;
+	space_warp.depth_rect_loc = GetShaderLocation(shader, "rlOpenXRDepthRect");
+	space_warp.depth_layer_loc = GetShaderLocation(shader, "rlOpenXRDepthLayer");
+	space_warp.reprojection_loc = GetShaderLocation(shader, "rlOpenXRReprojection");
+	space_warp.fbo = rlLoadFramebuffer(0, 0);
+	space_warp.vao = rlLoadVertexArray();
+
+	space_warp.infos.resize(c_view_count);
+	for (int view = 0; view < c_view_count; ++view)
+	{
+		const XrRect2Di rect{ { s_xr->multiview ? 0 : view * space_warp.view_extent.width, 0 }, space_warp.view_extent };
+		const uint32_t array_index = s_xr->multiview ? view : 0;
+
+		// The app space never moves relative to the play space, all motion is in the views
+		space_warp.infos[view] = XrCompositionLayerSpaceWarpInfoFB{
+			.type = XR_TYPE_COMPOSITION_LAYER_SPACE_WARP_INFO_FB,
+			.next = nullptr,
+			.layerFlags = 0,
+			.motionVectorSubImage = { .swapchain = space_warp.motion_vector_swapchain, .imageRect = rect, .imageArrayIndex = array_index },
+			.appSpaceDeltaPose = { .orientation = { 0.f, 0.f, 0.f, 1.f }, .position = { 0.f, 0.f, 0.f } },
+			.depthSubImage = { .swapchain = space_warp.depth_swapchain, .imageRect = rect, .imageArrayIndex = array_index },
+			.minDepth = 0.f,
+			.maxDepth = 1.f,
+			.nearZ = (float)RL_CULL_DISTANCE_NEAR,
+			.farZ = (float)RL_CULL_DISTANCE_FAR
+		};
+	}
+
+	return true;
+}
+
+static void space_warp_unload()
+{
+	auto& space_warp = s_xr->space_warp;
+
+	if (space_warp.shader.id != 0)
+	{
+		UnloadShader(space_warp.shader);
+	}
+	if (space_warp.fbo != 0)
+	{
+		rlUnloadFramebuffer(space_warp.fbo);
+	}
+	if (space_warp.vao != 0)
+	{
+		rlUnloadVertexArray(space_warp.vao);
+	}
+	if (space_warp.motion_vector_swapchain != XR_NULL_HANDLE)
+	{
+		xrDestroySwapchain(space_warp.motion_vector_swapchain);
+	}
+	if (space_warp.depth_swapchain != XR_NULL_HANDLE)
+	{
+		xrDestroySwapchain(space_warp.depth_swapchain);
+	}
+
+	space_warp = RLOpenXRSpaceWarp{};
+}
+
+// Projection * view of a located view, in play space
+static Matrix view_projection_matrix(const XrView& view)
+{
+	return MatrixMultiply(MatrixInvert(xr_matrix(view.pose)), xr_projection_matrix(view.fov));
+}
+
+static bool acquire_space_warp_image(XrSwapchain swapchain, const std::vector<XrSwapchainImageOpenGLKHR>& images, unsigned int* image)
+{
+	uint32_t image_index = 0;
+	XrSwapchainImageAcquireInfo acquire_info{ XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO };
+	XrResult result = xrAcquireSwapchainImage(swapchain, &acquire_info, &image_index);
+	if (!xr_check(result, "failed to aquire space warp swapchain image!"))
+		return false;
+
+	XrSwapchainImageWaitInfo wait_info{ XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
+	wait_info.timeout = XR_INFINITE_DURATION;
+	result = xrWaitSwapchainImage(swapchain, &wait_info);
+	if (!xr_check(result, "failed to wait for space warp swapchain image!"))
+		return false;
+
+	*image = images[image_index].image;
+	return true;
+}
+
+static void attach_space_warp_image(GLenum attachment, unsigned int texture, int view)
+{
+	if (s_xr->multiview)
+	{
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, attachment, texture, 0, view);
+	}
+	else
+	{
+		glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture, 0);
+	}
+}
+
+// Renders motion vectors and motion depth for every view, from the eye depth image that is still acquired.
+// Returns false when nothing was rendered, the frame is then submitted without SpaceWarp.
+static bool space_warp_render(unsigned int eye_depth_image)
+{
+	auto& space_warp = s_xr->space_warp;
+
+	Two<Matrix> view_projections;
+	for (int view = 0; view < c_view_count; ++view)
+	{
+		view_projections[view] = view_projection_matrix(s_xr->views[view]);
+	}
+	if (!space_warp.has_previous)
+	{
+		space_warp.previous_view_projections = view_projections;
+	}
+
+	unsigned int motion_vector_image = 0;
+	unsigned int depth_image = 0;
+	if (!acquire_space_warp_image(space_warp.motion_vector_swapchain, space_warp.motion_vector_images, &motion_vector_image))
+		return false;
+	if (!acquire_space_warp_image(space_warp.depth_swapchain, space_warp.depth_images, &depth_image))
+	{
+		XrSwapchainImageReleaseInfo release_info{ XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
+		xrReleaseSwapchainImage(space_warp.motion_vector_swapchain, &release_info);
+		return false;
+	}
+
+	const GLenum depth_attachment = gl_format_has_stencil(s_xr->depth_format) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+	const GLenum eye_depth_target = s_xr->multiview ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+	const float eye_width = (float)s_xr->swapchain_view_extent.width * (s_xr->multiview ? 1 : c_view_count);
+	const float eye_height = (float)s_xr->swapchain_view_extent.height;
+
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, space_warp.fbo);
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_ALWAYS);
+	glDepthMask(GL_TRUE);
+	glDisable(GL_BLEND);
+	glDisable(GL_CULL_FACE);
+
+	rlEnableShader(space_warp.shader.id);
+	rlActiveTextureSlot(0);
+	glBindTexture(eye_depth_target, eye_depth_image);
+	// Runtime created textures can default to mipmapped filtering, which leaves them incomplete for sampling
+	glTexParameteri(eye_depth_target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(eye_depth_target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	rlEnableVertexArray(space_warp.vao);
+
+	for (int view = 0; view < c_view_count; ++view)
+	{
+		attach_space_warp_image(GL_COLOR_ATTACHMENT0, motion_vector_image, view);
+		attach_space_warp_image(depth_attachment, depth_image, view);
+
+		const XrRect2Di& motion_rect = space_warp.infos[view].motionVectorSubImage.imageRect;
+		glViewport(motion_rect.offset.x, motion_rect.offset.y, motion_rect.extent.width, motion_rect.extent.height);
+
+		const XrRect2Di& eye_rect = s_xr->projection_views[view].subImage.imageRect;
+		const float depth_rect[4] = { eye_rect.offset.x / eye_width, eye_rect.offset.y / eye_height, eye_rect.extent.width / eye_width, eye_rect.extent.height / eye_height };
+		rlSetUniform(space_warp.depth_rect_loc, depth_rect, SHADER_UNIFORM_VEC4, 1);
+		rlSetUniform(space_warp.depth_layer_loc, &view, SHADER_UNIFORM_INT, 1);
+		rlSetUniformMatrix(space_warp.reprojection_loc, MatrixMultiply(MatrixInvert(view_projections[view]), space_warp.previous_view_projections[view]));
+
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+	}
+
+	rlDisableVertexArray();
+	glBindTexture(eye_depth_target, 0);
+	rlDisableShader();
+
+	// Back to rlgl's defaults
+	glDepthFunc(GL_LEQUAL);
+	glEnable(GL_BLEND);
+	glEnable(GL_CULL_FACE);
+	glDisable(GL_DEPTH_TEST);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+	XrSwapchainImageReleaseInfo release_info{ XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
+	XrResult result = xrReleaseSwapchainImage(space_warp.motion_vector_swapchain, &release_info);
+	bool released = xr_check(result, "failed to release motion vector swapchain image!");
+	result = xrReleaseSwapchainImage(space_warp.depth_swapchain, &release_info);
+	released = xr_check(result, "failed to release motion depth swapchain image!") && released;
+
+	space_warp.previous_view_projections = view_projections;
+	space_warp.has_previous = true;
+
+	return released;
+}
+
+// SpaceWarp info goes in front of the depth info in each projection view's chain
+static void chain_projection_views(bool space_warp)
+{
+	for (size_t view = 0; view < s_xr->projection_views.size(); ++view)
+	{
+		const void* depth_info = s_xr->extensions.depth_enabled ? &s_xr->depth_infos[view] : nullptr;
+		if (space_warp)
+		{
+			s_xr->space_warp.infos[view].next = depth_info;
+			s_xr->projection_views[view].next = &s_xr->space_warp.infos[view];
+		}
+		else
+		{
+			s_xr->projection_views[view].next = depth_info;
+		}
+	}
+}
+
+// Frame cache
+// Head, view and hand poses are asked for multiple times a frame, and every locate can be a call into the runtime's process.
+static void invalidate_frame_cache()
+{
+	s_xr->pose_cache.count = 0;
+	s_xr->pose_cache.next = 0;
+	s_xr->frame_time = 0;
+}
+
+// xrLocateSpace(), but each (space, base space, time) is only located once per frame. Chained structures in `location->next` are not cached.
+static XrResult locate_space_cached(XrSpace space, XrSpace base_space, XrTime time, XrSpaceLocation* location)
+{
+	if (location->next != nullptr)
+	{
+		return xrLocateSpace(space, base_space, time, location);
+	}
+
+	auto& cache = s_xr->pose_cache;
+	for (int i = 0; i < cache.count; ++i)
+	{
+		const auto& entry = cache.entries[i];
+		if (entry.space == space && entry.base_space == base_space && entry.time == time)
+		{
+			*location = entry.location;
+			return XR_SUCCESS;
+		}
+	}
+
+	const XrResult result = xrLocateSpace(space, base_space, time, location);
+	if (XR_SUCCEEDED(result))
+	{
+		cache.entries[cache.next] = RLOpenXRPoseCacheEntry{ space, base_space, time, *location };
+		cache.next = (cache.next + 1) % c_pose_cache_size;
+		cache.count = std::min(cache.count + 1, c_pose_cache_size);
+	}
+	return result;
+}
+
+// Hand tracking
+static void hand_tracking_load()
+{
+	if (!s_xr->extensions.hand_tracking_enabled)
+	{
+		return;
+	}
+
+	for (int hand = 0; hand < RLOPENXR_HAND_COUNT; ++hand)
+	{
+		const XrHandTrackerCreateInfoEXT create_info{
+			.type = XR_TYPE_HAND_TRACKER_CREATE_INFO_EXT,
+			.next = nullptr,
+			.hand = hand == RLOPENXR_HAND_LEFT ? XR_HAND_LEFT_EXT : XR_HAND_RIGHT_EXT,
+			.handJointSet = XR_HAND_JOINT_SET_DEFAULT_EXT
+		};
+		XrResult result = s_xr->extensions.xrCreateHandTrackerEXT(s_xr->data.session, &create_info, &s_xr->hand_trackers[hand]);
+		if (!xr_check(result, "Failed to create hand tracker %d", hand))
+		{
+			s_xr->hand_trackers[hand] = XR_NULL_HANDLE;
+		}
+	}
+}
+
+static void hand_tracking_unload()
+{
+	for (XrHandTrackerEXT& tracker : s_xr->hand_trackers)
+	{
+		if (tracker != XR_NULL_HANDLE)
+		{
+			s_xr->extensions.xrDestroyHandTrackerEXT(tracker);
+			tracker = XR_NULL_HANDLE;
+		}
+	}
+}
+
+static_assert(sizeof(RLOpenXRHandJoint) == 8 * sizeof(float), "hand_joint_matrices() loads a joint as two 4 float vectors");
+static_assert(RLOPENXR_HAND_JOINT_COUNT == XR_HAND_JOINT_COUNT_EXT);
+
+// Same as xr_matrix(), translation * rotation
+static void hand_joint_matrix(const RLOpenXRHandJoint& joint, Matrix* matrix)
+{
+	const Quaternion& q = joint.orientation;
+	const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+	*matrix = Matrix{
+		1.f - 2.f * (yy + zz), 2.f * (xy - wz), 2.f * (xz + wy), joint.position.x,
+		2.f * (xy + wz), 1.f - 2.f * (xx + zz), 2.f * (yz - wx), joint.position.y,
+		2.f * (xz - wy), 2.f * (yz + wx), 1.f - 2.f * (xx + yy), joint.position.z,
+		0.f, 0.f, 0.f, 1.f
+	};
+}
+
+// Converts 4 joints per iteration: the joints are transposed into one register per component, 
+// every matrix element is computed for 4 joints at once and transposed back into rows.
+static void hand_joint_matrices(const RLOpenXRHandJoint* joints, Matrix* matrices, int count)
+{
+	int i = 0;
+#if defined(RLOPENXR_SSE)
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 two = _mm_set1_ps(2.f);
+	const __m128 last_row = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const float* joint = (const float*)&joints[i];
+
+		// Each load holds (position.xyz, orientation.x) or (orientation.yzw, radius) of one joint, after transposing a register holds one component of all 4
+		__m128 px = _mm_loadu_ps(joint + 0), py = _mm_loadu_ps(joint + 8), pz = _mm_loadu_ps(joint + 16), qx = _mm_loadu_ps(joint + 24);
+		__m128 qy = _mm_loadu_ps(joint + 4), qz = _mm_loadu_ps(joint + 12), qw = _mm_loadu_ps(joint + 20), radius = _mm_loadu_ps(joint + 28);
+		_MM_TRANSPOSE4_PS(px, py, pz, qx);
+		_MM_TRANSPOSE4_PS(qy, qz, qw, radius);
+
+		const __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+		const __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+		const __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+		// One register per matrix element, transposed back into one register per joint row
+		__m128 rows[3][4] = {
+			{ _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), _mm_mul_ps(two, _mm_sub_ps(xy, wz)), _mm_mul_ps(two, _mm_add_ps(xz, wy)), px },
+			{ _mm_mul_ps(two, _mm_add_ps(xy, wz)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), _mm_mul_ps(two, _mm_sub_ps(yz, wx)), py },
+			{ _mm_mul_ps(two, _mm_sub_ps(xz, wy)), _mm_mul_ps(two, _mm_add_ps(yz, wx)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), pz }
+		};
+		for (auto& row : rows)
+		{
+			_MM_TRANSPOSE4_PS(row[0], row[1], row[2], row[3]);
+		}
+
+		// raylib's Matrix is stored row by row: m0, m4, m8, m12, m1, ...
+		for (int j = 0; j < 4; ++j)
+		{
+			float* matrix = (float*)&matrices[i + j];
+			_mm_storeu_ps(matrix + 0, rows[0][j]);
+			_mm_storeu_ps(matrix + 4, rows[1][j]);
+			_mm_storeu_ps(matrix + 8, rows[2][j]);
+			_mm_storeu_ps(matrix + 12, last_row);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		hand_joint_matrix(joints[i], &matrices[i]);
+	}
+}
+
+// Controller models
+static bool read_file(const std::string& path, std::vector<uint8_t>* bytes)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	bytes->resize(size > 0 ? (size_t)size : 0);
+	const bool success = size > 0 && fread(bytes->data(), 1, bytes->size(), file) == bytes->size();
+	fclose(file);
+	return success;
+}
+
+static bool write_file(const std::string& path, const std::vector<uint8_t>& bytes)
+{
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	const bool success = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+	fclose(file);
+	return success;
+}
+
+// Model keys are only unique per runtime, so the runtime is part of the cache file name. Empty when the cache is disabled.
+static std::string controller_model_cache_prefix()
+{
+	if (s_config.controller_model_cache_dir.empty())
+	{
+		return {};
+	}
+
+	XrInstanceProperties instance_props{ XR_TYPE_INSTANCE_PROPERTIES };
+	XrResult result = xrGetInstanceProperties(s_xr->data.instance, &instance_props);
+	if (!xr_check(result, "Failed to get the runtime name, controller models are not cached"))
+	{
+		return {};
+	}
+
+	std::string runtime_name = instance_props.runtimeName;
+	std::replace_if(runtime_name.begin(), runtime_name.end(), [](char c) { return !isalnum((unsigned char)c); }, '_');
+
+	char runtime_version[32];
+	snprintf(runtime_version, sizeof(runtime_version), "_%u.%u.%u_", XR_VERSION_MAJOR(instance_props.runtimeVersion),
+		XR_VERSION_MINOR(instance_props.runtimeVersion), XR_VERSION_PATCH(instance_props.runtimeVersion));
+
+	return s_config.controller_model_cache_dir + "/rlOpenXR_controller_" + runtime_name + runtime_version;
+}
+
+static Image controller_model_decode_image(const cgltf_image& image)
+{
+	// Binary glTF embeds its images in a buffer view
+	if (image.buffer_view == nullptr || image.buffer_view->buffer->data == nullptr)
+	{
+		return Image{};
+	}
+
+	const char* file_type = image.mime_type != nullptr && strcmp(image.mime_type, "image/jpeg") == 0 ? ".jpg" : ".png";
+	const unsigned char* data = (const unsigned char*)image.buffer_view->buffer->data + image.buffer_view->offset;
+	return LoadImageFromMemory(file_type, data, (int)image.buffer_view->size);
+}
+
+// Node transforms are baked into the vertices, controller models are drawn as one rigid object.
+// Everything that is expensive happens here, so the GL thread only has to upload buffers and textures.
+static bool controller_model_decode(const std::vector<uint8_t>& glb, RLOpenXRControllerModelData* decoded)
+{
+	cgltf_options options{};
+	cgltf_data* gltf = nullptr;
+	if (cgltf_parse(&options, glb.data(), glb.size(), &gltf) != cgltf_result_success)
+	{
+		return false;
+	}
+
+	// Controller models are self contained, buffers only point into the binary chunk of `glb`
+	if (cgltf_load_buffers(&options, gltf, nullptr) != cgltf_result_success)
+	{
+		cgltf_free(gltf);
+		return false;
+	}
+
+	// One extra material for primitives without one
+	const size_t material_count = gltf->materials_count + 1;
+	decoded->colors.assign(material_count, WHITE);
+	decoded->images.assign(material_count, Image{});
+	for (size_t i = 0; i < gltf->materials_count; ++i)
+	{
+		const cgltf_material& material = gltf->materials[i];
+		if (!material.has_pbr_metallic_roughness)
+		{
+			continue;
+		}
+
+		const cgltf_pbr_metallic_roughness& pbr = material.pbr_metallic_roughness;
+		decoded->colors[i] = Color{
+			(unsigned char)(Clamp(pbr.base_color_factor[0], 0.f, 1.f) * 255.f),
+			(unsigned char)(Clamp(pbr.base_color_factor[1], 0.f, 1.f) * 255.f),
+			(unsigned char)(Clamp(pbr.base_color_factor[2], 0.f, 1.f) * 255.f),
+			(unsigned char)(Clamp(pbr.base_color_factor[3], 0.f, 1.f) * 255.f)
+		};
+		if (pbr.base_color_texture.texture != nullptr && pbr.base_color_texture.texture->image != nullptr)
+		{
+			decoded->images[i] = controller_model_decode_image(*pbr.base_color_texture.texture->image);
+		}
+	}
+
+	for (size_t n = 0; n < gltf->nodes_count; ++n)
+	{
+		const cgltf_node& node = gltf->nodes[n];
+		if (node.mesh == nullptr)
+		{
+			continue;
+		}
+
+		// cgltf is column major, raylib's Matrix declares its fields row by row
+		float world[16];
+		cgltf_node_transform_world(&node, world);
+		const Matrix transform{
+			world[0], world[4], world[8], world[12],
+			world[1], world[5], world[9], world[13],
+			world[2], world[6], world[10], world[14],
+			world[3], world[7], world[11], world[15]
+		};
+		Matrix normal_transform = transform;
+		normal_transform.m12 = normal_transform.m13 = normal_transform.m14 = 0.f;
+
+		for (size_t p = 0; p < node.mesh->primitives_count; ++p)
+		{
+			const cgltf_primitive& primitive = node.mesh->primitives[p];
+			if (primitive.type != cgltf_primitive_type_triangles)
+			{
+				continue;
 			}
 
-										  // destroy session, skip render loop, exit render loop and quit
-			case XR_SESSION_STATE_LOSS_PENDING:
-			case XR_SESSION_STATE_EXITING:
-				result = xrDestroySession(s_xr->data.session);
-				if (!xr_check(result, "Failed to destroy session!"))
-					return;
-				s_xr->run_framecycle = false;
+			const cgltf_accessor* positions = nullptr;
+			const cgltf_accessor* normals = nullptr;
+			const cgltf_accessor* texcoords = nullptr;
+			for (size_t a = 0; a < primitive.attributes_count; ++a)
+			{
+				const cgltf_attribute& attribute = primitive.attributes[a];
+				if (attribute.type == cgltf_attribute_type_position) positions = attribute.data;
+				if (attribute.type == cgltf_attribute_type_normal) normals = attribute.data;
+				if (attribute.type == cgltf_attribute_type_texcoord && attribute.index == 0) texcoords = attribute.data;
+			}
+			if (positions == nullptr)
+			{
+				continue;
+			}
 
-				break; // state handling switch
+			// raylib indices are 16 bit, larger primitives are expanded into a plain triangle list
+			const size_t index_count = primitive.indices != nullptr ? primitive.indices->count : positions->count;
+			const bool indexed = primitive.indices != nullptr && positions->count <= std::numeric_limits<unsigned short>::max();
+			const bool expanded = primitive.indices != nullptr && !indexed;
+			const size_t vertex_count = expanded ? index_count : positions->count;
+
+			Mesh mesh{};
+			mesh.vertexCount = (int)vertex_count;
+			mesh.triangleCount = (int)(index_count / 3);
+			mesh.vertices = (float*)MemAlloc((unsigned int)(vertex_count * 3 * sizeof(float)));
+			mesh.normals = (float*)MemAlloc((unsigned int)(vertex_count * 3 * sizeof(float)));
+			mesh.texcoords = (float*)MemAlloc((unsigned int)(vertex_count * 2 * sizeof(float)));
+
+			for (size_t i = 0; i < vertex_count; ++i)
+			{
+				const size_t source = expanded ? cgltf_accessor_read_index(primitive.indices, i) : i;
+
+				Vector3 position{};
+				cgltf_accessor_read_float(positions, source, &position.x, 3);
+				position = Vector3Transform(position, transform);
+				memcpy(&mesh.vertices[i * 3], &position, sizeof(position));
+
+				if (normals != nullptr)
+				{
+					Vector3 normal{};
+					cgltf_accessor_read_float(normals, source, &normal.x, 3);
+					normal = Vector3Normalize(Vector3Transform(normal, normal_transform));
+					memcpy(&mesh.normals[i * 3], &normal, sizeof(normal));
+				}
+
+				if (texcoords != nullptr)
+				{
+					cgltf_accessor_read_float(texcoords, source, &mesh.texcoords[i * 2], 2);
+				}
 			}
-			break; // session event handling switch
+
+			if (indexed)
+			{
+				mesh.indices = (unsigned short*)MemAlloc((unsigned int)(index_count * sizeof(unsigned short)));
+				for (size_t i = 0; i < index_count; ++i)
+				{
+					mesh.indices[i] = (unsigned short)cgltf_accessor_read_index(primitive.indices, i);
+				}
+			}
+
+			decoded->meshes.push_back(mesh);
+			decoded->mesh_materials.push_back(primitive.material != nullptr ? (int)(primitive.material - gltf->materials) : (int)gltf->materials_count);
 		}
-		case XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED: {
-			printf("EVENT: interaction profile changed!\n");
-			XrEventDataInteractionProfileChanged* event =
-				(XrEventDataInteractionProfileChanged*)&runtime_event;
-			(void)event;
+	}
+
+	cgltf_free(gltf);
+	return !decoded->meshes.empty();
+}
+
+// The glTF comes from the disk cache when it decodes, otherwise from the runtime
+static void controller_model_load(XrSession session, PFN_xrLoadControllerModelMSFT xrLoadControllerModelMSFT, const std::string& cache_prefix, RLOpenXRControllerModelData* decoded)
+{
+	char key_string[24];
+	snprintf(key_string, sizeof(key_string), "%016llx", (unsigned long long)decoded->key);
+	const std::string cache_path = cache_prefix.empty() ? std::string{} : cache_prefix + key_string + ".glb";
+
+	std::vector<uint8_t> glb;
+	if (!cache_path.empty() && read_file(cache_path, &glb))
+	{
+		if (controller_model_decode(glb, decoded))
+		{
+			return;
+		}
+
+		// Probably a partially written file, the runtime's copy replaces it
+		const XrControllerModelKeyMSFT key = decoded->key;
+		*decoded = RLOpenXRControllerModelData{};
+		decoded->key = key;
+	}
+
+	uint32_t glb_size = 0;
+	XrResult result = xrLoadControllerModelMSFT(session, decoded->key, 0, &glb_size, nullptr);
+	if (!xr_check(result, "Failed to get the size of controller model %s", key_string))
+		return;
+
+	glb.resize(glb_size);
+	result = xrLoadControllerModelMSFT(session, decoded->key, glb_size, &glb_size, glb.data());
+	if (!xr_check(result, "Failed to load controller model %s", key_string))
+		return;
+
+	if (!controller_model_decode(glb, decoded))
+	{
+		RLOPENXR_LOG_WARNING("Failed to decode controller model %s", key_string);
+		return;
+	}
+
+	if (!cache_path.empty() && !write_file(cache_path, glb))
+	{
+		RLOPENXR_LOG_WARNING("Failed to write controller model cache '%s'", cache_path.c_str());
+	}
+}
+
+static void controller_model_thread(XrSession session, PFN_xrLoadControllerModelMSFT xrLoadControllerModelMSFT, std::string cache_prefix, RLOpenXRControllerModelLoader* loader)
+{
+	while (true)
+	{
+		RLOpenXRControllerModelData decoded;
+		{
+			std::unique_lock lock(loader->mutex);
+			loader->wake.wait(lock, [loader] { return loader->stop || !loader->requests.empty(); });
+			if (loader->stop)
+			{
+				return;
+			}
+
+			decoded.key = loader->requests.front();
+			loader->requests.erase(loader->requests.begin());
+		}
+
+		controller_model_load(session, xrLoadControllerModelMSFT, cache_prefix, &decoded);
+
+		std::lock_guard lock(loader->mutex);
+		loader->results.push_back(std::move(decoded));
+	}
+}
+
+static void start_controller_model_thread()
+{
+	if (!s_xr->extensions.controller_model_enabled)
+	{
+		return;
+	}
+
+	auto& loader = s_xr->controller_model_loader;
+	assert(!loader.thread.joinable());
+
+	loader.stop = false;
+	loader.thread = std::thread(&controller_model_thread, s_xr->data.session, s_xr->extensions.xrLoadControllerModelMSFT, controller_model_cache_prefix(), &loader);
+}
+
+static void stop_controller_model_thread()
+{
+	auto& loader = s_xr->controller_model_loader;
+	if (!loader.thread.joinable())
+	{
+		return;
+	}
+
+	// A model in flight is finished first, the runtime call can't be interrupted
+	{
+		std::lock_guard lock(loader.mutex);
+		loader.stop = true;
+		loader.requests.clear();
+	}
+	loader.wake.notify_one();
+	loader.thread.join();
+}
+
+static RLOpenXRControllerModel* find_controller_model(XrControllerModelKeyMSFT key)
+{
+	auto it = std::find_if(s_xr->controller_models.begin(), s_xr->controller_models.end(),
+		[key](const RLOpenXRControllerModel& controller_model) { return controller_model.key == key; });
+	return it != s_xr->controller_models.end() ? &*it : nullptr;
+}
+
+// Takes ownership of the decoded meshes, materials get their textures in later slices
+static void controller_model_begin_upload(RLOpenXRControllerModel& controller_model)
+{
+	RLOpenXRControllerModelData& decoded = controller_model.decoded;
+	Model& model = controller_model.model;
+
+	model.transform = MatrixIdentity();
+
+	model.meshCount = (int)decoded.meshes.size();
+	model.meshes = (Mesh*)MemAlloc((unsigned int)(model.meshCount * sizeof(Mesh)));
+	model.meshMaterial = (int*)MemAlloc((unsigned int)(model.meshCount * sizeof(int)));
+	std::copy(decoded.meshes.begin(), decoded.meshes.end(), model.meshes);
+	std::copy(decoded.mesh_materials.begin(), decoded.mesh_materials.end(), model.meshMaterial);
+	decoded.meshes.clear();
+
+	model.materialCount = (int)decoded.colors.size();
+	model.materials = (Material*)MemAlloc((unsigned int)(model.materialCount * sizeof(Material)));
+	for (int i = 0; i < model.materialCount; ++i)
+	{
+		model.materials[i] = LoadMaterialDefault();
+		model.materials[i].maps[MATERIAL_MAP_DIFFUSE].color = decoded.colors[i];
+	}
+}
+
+// One texture or mesh per call
+static void controller_model_upload_slice(RLOpenXRControllerModel& controller_model)
+{
+	Model& model = controller_model.model;
+
+	if (controller_model.uploaded_materials < model.materialCount)
+	{
+		const int material = controller_model.uploaded_materials++;
+		Image& image = controller_model.decoded.images[material];
+		if (image.data != nullptr)
+		{
+			model.materials[material].maps[MATERIAL_MAP_DIFFUSE].texture = LoadTextureFromImage(image);
+			UnloadImage(image);
+			image = Image{};
+		}
+	}
+	else if (controller_model.uploaded_meshes < model.meshCount)
+	{
+		UploadMesh(&model.meshes[controller_model.uploaded_meshes++], false);
+	}
+
+	controller_model.ready = controller_model.uploaded_materials == model.materialCount && controller_model.uploaded_meshes == model.meshCount;
+}
+
+// Called every rlOpenXRUpdate(), never blocks on the loader thread
+static void controller_models_update()
+{
+	auto& loader = s_xr->controller_model_loader;
+	if (!loader.thread.joinable())
+	{
+		return;
+	}
+
+	// Keys are only known once the runtime picked an interaction profile
+	if (s_xr->controller_model_keys_dirty && s_xr->session_running)
+	{
+		s_xr->controller_model_keys_dirty = false;
+
+		for (int hand = 0; hand < RLOPENXR_HAND_COUNT; ++hand)
+		{
+			XrControllerModelKeyStateMSFT key_state{ XR_TYPE_CONTROLLER_MODEL_KEY_STATE_MSFT };
+			XrResult result = s_xr->extensions.xrGetControllerModelKeyMSFT(s_xr->data.session, rlOpenXRPath(c_hand_paths[hand]), &key_state);
+			const XrControllerModelKeyMSFT key = XR_SUCCEEDED(result) ? key_state.modelKey : XR_NULL_CONTROLLER_MODEL_KEY_MSFT;
+			s_xr->controller_model_keys[hand] = key;
+
+			if (key != XR_NULL_CONTROLLER_MODEL_KEY_MSFT && find_controller_model(key) == nullptr)
+			{
+				s_xr->controller_models.push_back(RLOpenXRControllerModel{ .key = key });
+
+				std::lock_guard lock(loader.mutex);
+				loader.requests.push_back(key);
+				loader.wake.notify_one();
+			}
+		}
+	}
+
+	{
+		std::lock_guard lock(loader.mutex);
+		for (RLOpenXRControllerModelData& decoded : loader.results)
+		{
+			RLOpenXRControllerModel* controller_model = find_controller_model(decoded.key);
+			assert(controller_model != nullptr);
+			if (!decoded.meshes.empty())
+			{
+				controller_model->decoded = std::move(decoded);
+				controller_model_begin_upload(*controller_model);
+			}
+		}
+		loader.results.clear();
+	}
+
+	int uploads = 0;
+	for (RLOpenXRControllerModel& controller_model : s_xr->controller_models)
+	{
+		while (controller_model.model.meshCount > 0 && !controller_model.ready && uploads < c_controller_model_uploads_per_frame)
+		{
+			controller_model_upload_slice(controller_model);
+			++uploads;
+		}
+	}
+}
+
+static void controller_models_unload()
+{
+	stop_controller_model_thread();
+
+	for (RLOpenXRControllerModel& controller_model : s_xr->controller_models)
+	{
+		if (controller_model.model.meshes != nullptr)
+		{
+			UnloadModel(controller_model.model);
+		}
+	}
+	s_xr->controller_models.clear();
+}
+
+// Composition layers
+
+// Layer content is premultiplied: rlOpenXRBeginLayer() blends the alpha channel with GL_ONE, GL_ONE_MINUS_SRC_ALPHA,
+// so drawing with raylib's alpha blending onto a transparent clear leaves color * alpha in the image.
+constexpr XrCompositionLayerFlags c_layer_flags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+
+// One framebuffer per swapchain image, like create_swapchain_framebuffers(). Layers have no depth.
+static bool create_layer_swapchain(RLOpenXRLayer& layer, int width, int height, XrSwapchainCreateFlags create_flags)
+{
+	const XrSwapchainCreateInfo swapchain_create_info = {
+		.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
+		.next = NULL,
+		.createFlags = create_flags,
+		.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT,
+		.format = s_xr->color_format,
+		.sampleCount = 1,
+		.width = (uint32_t)width,
+		.height = (uint32_t)height,
+		.faceCount = 1,
+		.arraySize = 1,
+		.mipCount = 1,
+	};
+
+	XrResult result = xrCreateSwapchain(s_xr->data.session, &swapchain_create_info, &layer.swapchain);
+	if (!xr_check(result, "Failed to create a %dx%d layer swapchain", width, height))
+		return false;
+
+	uint32_t image_count = 0;
+	result = xrEnumerateSwapchainImages(layer.swapchain, 0, &image_count, NULL);
+	if (!xr_check(result, "Failed to enumerate layer swapchain images"))
+		return false;
+
+	layer.swapchain_images.resize(image_count, { .type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR, .next = nullptr });
+	result = xrEnumerateSwapchainImages(layer.swapchain, image_count, &image_count, (XrSwapchainImageBaseHeader*)layer.swapchain_images.data());
+	if (!xr_check(result, "Failed to enumerate layer swapchain images"))
+		return false;
+
+	layer.width = width;
+	layer.height = height;
+
+	layer.fbos.resize(image_count);
+	for (uint32_t i = 0; i < image_count; ++i)
+	{
+		layer.fbos[i] = rlLoadFramebuffer(width, height);
+		rlFramebufferAttach(layer.fbos[i], layer.swapchain_images[i].image, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+		if (!rlFramebufferComplete(layer.fbos[i]))
+		{
+			RLOPENXR_LOG_ERROR("rlOpenXR layer framebuffer for image %u is not complete.", i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void destroy_layer(RLOpenXRLayer& layer)
+{
+	for (unsigned int fbo : layer.fbos)
+	{
+		rlUnloadFramebuffer(fbo);
+	}
+
+	if (layer.swapchain != XR_NULL_HANDLE)
+	{
+		xrDestroySwapchain(layer.swapchain);
+	}
+
+	layer = RLOpenXRLayer{};
+}
+
+// Index of an unused layer slot, the swapchain is created by the caller
+static int allocate_layer()
+{
+	auto it = std::find_if(s_xr->layers.begin(), s_xr->layers.end(), [](const RLOpenXRLayer& layer) { return layer.swapchain == XR_NULL_HANDLE; });
+	if (it != s_xr->layers.end())
+	{
+		return (int)(it - s_xr->layers.begin());
+	}
+
+	s_xr->layers.emplace_back();
+	return (int)s_xr->layers.size() - 1;
+}
+
+// Layer with a swapchain, the type specific struct is filled in by the caller. -1 on failure
+static int create_layer(int width, int height, bool static_image)
+{
+	const int index = allocate_layer();
+	RLOpenXRLayer& layer = s_xr->layers[index];
+	if (!create_layer_swapchain(layer, width, height, static_image ? XR_SWAPCHAIN_CREATE_STATIC_IMAGE_BIT : 0))
+	{
+		destroy_layer(layer);
+		return -1;
+	}
+
+	layer.static_image = static_image;
+	return index;
+}
+
+static XrSpace layer_space(RLOpenXRLayerSpace space)
+{
+	return space == RLOPENXR_LAYER_SPACE_VIEW ? s_xr->data.view_space : s_xr->data.play_space;
+}
+
+static XrSwapchainSubImage layer_sub_image(const RLOpenXRLayer& layer)
+{
+	return XrSwapchainSubImage{
+		.swapchain = layer.swapchain,
+		.imageRect = { .offset = { 0, 0 }, .extent = { layer.width, layer.height } },
+		.imageArrayIndex = 0
+	};
+}
+
+static XrPosef layer_pose(Vector3 position, Quaternion orientation)
+{
+	return XrPosef{
+		.orientation = { orientation.x, orientation.y, orientation.z, orientation.w },
+		.position = { position.x, position.y, position.z }
+	};
+}
+
+static bool is_layer_submitted(const RLOpenXRLayer& layer, bool background)
+{
+	return layer.swapchain != XR_NULL_HANDLE && layer.visible && layer.has_image && layer.background == background;
+}
+
+static bool has_background_layer()
+{
+	for (const RLOpenXRLayer& layer : s_xr->layers)
+	{
+		if (is_layer_submitted(layer, true))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Background layers, layer_projection, then the other layers. Each group is in index order.
+// A layer without a released image has nothing to show yet.
+static void update_layers_pointers()
+{
+	s_xr->layers_pointers.clear();
+
+	for (RLOpenXRLayer& layer : s_xr->layers)
+	{
+		if (is_layer_submitted(layer, true) && s_xr->layers_pointers.size() + 1 < s_xr->max_layer_count)
+		{
+			s_xr->layers_pointers.push_back(&layer.header);
+		}
+	}
+
+	// The eye buffers are blended over the background by their alpha, so the background shows where they are cleared to BLANK
+	const bool has_background = !s_xr->layers_pointers.empty();
+	s_xr->layer_projection.layerFlags = has_background ? XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT : 0;
+	s_xr->layers_pointers.push_back((XrCompositionLayerBaseHeader*)&s_xr->layer_projection);
+
+	for (RLOpenXRLayer& layer : s_xr->layers)
+	{
+		if (is_layer_submitted(layer, false) && s_xr->layers_pointers.size() < s_xr->max_layer_count)
+		{
+			s_xr->layers_pointers.push_back(&layer.header);
+		}
+	}
+}
+
+// Action manager
+static RLOpenXRActionState* managed_action_state(const RLOpenXRManagedAction& action, int subaction)
+{
+	return &s_xr->action_manager.states[action.state_offset + subaction];
+}
+
+static void update_action_edges(RLOpenXRActionState* state, bool down)
+{
+	state->pressed = down && !state->down;
+	state->released = !down && state->down;
+	state->down = down;
+}
+
+static void refresh_action_state(const RLOpenXRManagedAction& action, int subaction, XrTime time)
+{
+	auto& manager = s_xr->action_manager;
+	RLOpenXRActionState* state = managed_action_state(action, subaction);
+
+	XrActionStateGetInfo get_info{
+		.type = XR_TYPE_ACTION_STATE_GET_INFO,
+		.next = nullptr,
+		.action = action.handle,
+		.subactionPath = action.subaction_count > 1 ? manager.hand_paths[subaction] : XR_NULL_PATH
+	};
+
+	XrResult result = XR_SUCCESS;
+	switch (action.type)
+	{
+	case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+		XrActionStateBoolean xr_state{ XR_TYPE_ACTION_STATE_BOOLEAN };
+		result = xrGetActionStateBoolean(s_xr->data.session, &get_info, &xr_state);
+		state->active = XR_SUCCEEDED(result) && xr_state.isActive;
+		state->changed = state->active && xr_state.changedSinceLastSync;
+		state->value = (state->active && xr_state.currentState) ? 1.f : 0.f;
+		update_action_edges(state, state->value > 0.f);
+		break;
+	}
+	case XR_ACTION_TYPE_FLOAT_INPUT: {
+		XrActionStateFloat xr_state{ XR_TYPE_ACTION_STATE_FLOAT };
+		result = xrGetActionStateFloat(s_xr->data.session, &get_info, &xr_state);
+		state->active = XR_SUCCEEDED(result) && xr_state.isActive;
+		state->changed = state->active && xr_state.changedSinceLastSync;
+		state->value = state->active ? xr_state.currentState : 0.f;
+		update_action_edges(state, state->value > c_action_press_threshold);
+		break;
+	}
+	case XR_ACTION_TYPE_VECTOR2F_INPUT: {
+		XrActionStateVector2f xr_state{ XR_TYPE_ACTION_STATE_VECTOR2F };
+		result = xrGetActionStateVector2f(s_xr->data.session, &get_info, &xr_state);
+		state->active = XR_SUCCEEDED(result) && xr_state.isActive;
+		state->changed = state->active && xr_state.changedSinceLastSync;
+		state->vector2 = state->active ? Vector2{ xr_state.currentState.x, xr_state.currentState.y } : Vector2{ 0.f, 0.f };
+		state->value = Vector2Length(state->vector2);
+		update_action_edges(state, state->value > c_action_press_threshold);
+		break;
+	}
+	case XR_ACTION_TYPE_POSE_INPUT: {
+		XrActionStatePose xr_state{ XR_TYPE_ACTION_STATE_POSE };
+		result = xrGetActionStatePose(s_xr->data.session, &get_info, &xr_state);
+		state->active = XR_SUCCEEDED(result) && xr_state.isActive;
+		state->pose_valid = false;
+		if (state->active)
+		{
+			// Goes through the pose cache, so rlOpenXRUpdateHands() on the same space is free
+			XrSpaceLocation location{ XR_TYPE_SPACE_LOCATION };
+			result = locate_space_cached(action.spaces[subaction], s_xr->data.play_space, time, &location);
+			const XrSpaceLocationFlags valid_bits = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+			if (XR_SUCCEEDED(result) && (location.locationFlags & valid_bits) == valid_bits)
+			{
+				const XrPosef& pose = location.pose;
+				state->pose_valid = true;
+				state->position = Vector3{ pose.position.x, pose.position.y, pose.position.z };
+				state->orientation = Quaternion{ pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w };
+			}
+		}
+		break;
+	}
+	default: assert(false && "Unknown action type");
+	}
+
+	xr_check(result, "Failed to get the state of action %d", (int)(&action - manager.actions.data()));
+}
+
+// One xrSyncActions() for every active set, then every registered action's state is copied into the flat state array
+static void sync_managed_actions()
+{
+	auto& manager = s_xr->action_manager;
+	if (!manager.attached || !s_xr->session_running)
+	{
+		return;
+	}
+
+	manager.active_sets.clear();
+	for (const auto& set : manager.sets)
+	{
+		if (set.active)
+		{
+			manager.active_sets.push_back(XrActiveActionSet{ set.handle, XR_NULL_PATH });
+		}
+	}
+
+	if (!manager.active_sets.empty())
+	{
+		const XrActionsSyncInfo sync_info{
+			.type = XR_TYPE_ACTIONS_SYNC_INFO,
+			.next = nullptr,
+			.countActiveActionSets = (uint32_t)manager.active_sets.size(),
+			.activeActionSets = manager.active_sets.data()
+		};
+		const XrResult result = xrSyncActions(s_xr->data.session, &sync_info);
+		if (!xr_check(result, "Failed to sync the managed actions"))
+		{
+			return;
+		}
+	}
+
+	const XrTime time = rlOpenXRGetTime();
+	for (const auto& action : manager.actions)
+	{
+		const bool set_active = manager.sets[action.action_set].active;
+		for (int subaction = 0; subaction < action.subaction_count; ++subaction)
+		{
+			if (set_active)
+			{
+				refresh_action_state(action, subaction, time);
+			}
+			else
+			{
+				RLOpenXRActionState* state = managed_action_state(action, subaction);
+				update_action_edges(state, false);
+				state->active = false;
+				state->changed = false;
+			}
+		}
+	}
+}
+
+static void store_space_location(RLOpenXRSpaceLocations* locations, int index, XrSpaceLocationFlags flags, const XrPosef& pose)
+{
+	locations->position_x[index] = pose.position.x;
+	locations->position_y[index] = pose.position.y;
+	locations->position_z[index] = pose.position.z;
+	locations->orientation_x[index] = pose.orientation.x;
+	locations->orientation_y[index] = pose.orientation.y;
+	locations->orientation_z[index] = pose.orientation.z;
+	locations->orientation_w[index] = pose.orientation.w;
+	locations->location_flags[index] = flags;
+}
+
+// Events
+static bool is_session_visible(XrSessionState state)
+{
+	return state == XR_SESSION_STATE_VISIBLE || state == XR_SESSION_STATE_FOCUSED;
+}
+
+static void push_event(const RLOpenXREvent& event)
+{
+	auto& queue = s_xr->event_queue;
+
+	if (queue.callbacks[event.type] != nullptr)
+	{
+		queue.callbacks[event.type](&event, queue.callback_user_data[event.type]);
+		return;
+	}
+
+	const uint32_t head = queue.head.load(std::memory_order_relaxed);
+	if (head - queue.tail.load(std::memory_order_acquire) == c_event_queue_capacity)
+	{
+		queue.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	queue.events[head % c_event_queue_capacity] = event;
+	queue.head.store(head + 1, std::memory_order_release);
+}
+
+// Pipelined xrWaitFrame
+static void frame_wait_thread(XrSession session, RLOpenXRFrameWaiter* waiter)
+{
+	while (true)
+	{
+		// Wait until the main thread took the previously published frame state
+		const uint64_t published = waiter->published.load(std::memory_order_relaxed);
+		uint64_t consumed = waiter->consumed.load(std::memory_order_acquire);
+		while (consumed != published && (consumed & c_frame_waiter_stop_bit) == 0)
+		{
+			waiter->consumed.wait(consumed, std::memory_order_acquire);
+			consumed = waiter->consumed.load(std::memory_order_acquire);
+		}
+		if (consumed & c_frame_waiter_stop_bit)
+		{
+			return;
+		}
+
+		// Blocks until xrBeginFrame() was called for the previous frame, and then until the runtime wants the next frame
+		XrFrameWaitInfo frame_wait_info = { .type = XR_TYPE_FRAME_WAIT_INFO, .next = NULL };
+		XrFrameState frame_state{ XR_TYPE_FRAME_STATE };
+		const int64_t wait_start = steady_time_ns();
+		waiter->slot_result = xrWaitFrame(session, &frame_wait_info, &frame_state);
+		waiter->slot_wait_ns = steady_time_ns() - wait_start;
+		waiter->slot = frame_state;
+
+		waiter->published.store(published + 1, std::memory_order_release);
+		waiter->published.notify_one();
+	}
+}
+
+static void start_frame_wait_thread()
+{
+	auto& waiter = s_xr->frame_waiter;
+	assert(!waiter.thread.joinable());
+
+	waiter.published.store(0, std::memory_order_relaxed);
+	waiter.consumed.store(0, std::memory_order_relaxed);
+	s_xr->pipelined_frame_acquired = false;
+
+	waiter.thread = std::thread(&frame_wait_thread, s_xr->data.session, &waiter);
+}
+
+static void stop_frame_wait_thread()
+{
+	auto& waiter = s_xr->frame_waiter;
+	if (!waiter.thread.joinable())
+	{
+		return;
+	}
+
+	// An xrWaitFrame() in flight returns once its display period is up, the last frame was already begun.
+	waiter.consumed.fetch_or(c_frame_waiter_stop_bit, std::memory_order_release);
+	waiter.consumed.notify_one();
+	waiter.thread.join();
+	s_xr->pipelined_frame_acquired = false;
+}
+
+// Takes the frame state published by the wait thread into s_xr->frame_state.
+// Returns false if xrWaitFrame() failed, or if nothing is published yet and `block` is false.
+static bool acquire_pipelined_frame_state(bool block)
+{
+	auto& waiter = s_xr->frame_waiter;
+
+	const uint64_t consumed = waiter.consumed.load(std::memory_order_relaxed);
+	uint64_t published = waiter.published.load(std::memory_order_acquire);
+	if (published == consumed)
+	{
+		if (!block)
+		{
+			return false;
+		}
+
+		waiter.published.wait(consumed, std::memory_order_acquire);
+		published = waiter.published.load(std::memory_order_acquire);
+	}
+
+	const XrResult result = waiter.slot_result;
+	s_xr->frame_state = waiter.slot;
+	invalidate_frame_cache();
+	if (XR_SUCCEEDED(result))
+	{
+		frame_stats_record_wait(waiter.slot, waiter.slot_wait_ns);
+	}
+
+	// Hand the slot back, this lets the thread start waiting on the next frame
+	waiter.consumed.store(published, std::memory_order_release);
+	waiter.consumed.notify_one();
+
+	return xr_check(result, "xrWaitFrame() was not successful, skipping this frame");
+}
+
+
+// Functions
+// ============================================================================
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void rlOpenXRSetConfigFlags(unsigned int flags)
+{
+	assert(s_xr == nullptr && "Config flags have to be set before rlOpenXRSetup()");
+	s_config.flags = flags;
+}
+
+void rlOpenXRSetSwapchainColorFormats(const int64_t* formats, int count)
+{
+	assert(s_xr == nullptr && "Swapchain formats have to be set before rlOpenXRSetup()");
+	assert(formats != nullptr && count > 0);
+	s_config.color_formats.assign(formats, formats + count);
+}
+
+void rlOpenXRSetSwapchainDepthFormats(const int64_t* formats, int count)
+{
+	assert(s_xr == nullptr && "Swapchain formats have to be set before rlOpenXRSetup()");
+	assert(formats != nullptr && count > 0);
+	s_config.depth_formats.assign(formats, formats + count);
+}
+
+static bool setup()
+{
+	assert(s_xr == nullptr);
+	s_xr = std::make_unique<RLOpenXRAllData>();
+
+	start_log_thread();
+
+	XrResult result = XR_SUCCESS;
+
+	if (s_config.flags & RLOPENXR_FLAG_HEADLESS)
+	{
+#if defined(RLOPENXR_PLATFORM_LINUX)
+		// No window, so rlOpenXR creates the GL context and initialises rlgl the same way InitWindow() would.
+		if (!wrapped_eglCreateHeadlessContext(c_headless_framebuffer_width, c_headless_framebuffer_height))
+		{
+			RLOPENXR_LOG_ERROR("rlOpenXR failed to create a headless EGL context.");
+			return false;
+		}
+		s_xr->headless = true;
+
+		rlLoadExtensions((void*)&wrapped_eglGetProcAddress);
+		rlglInit(c_headless_framebuffer_width, c_headless_framebuffer_height);
+#else
+		RLOPENXR_LOG_ERROR("rlOpenXR headless mode is only supported on Linux.");
+		return false;
+#endif
+	}
+
+	//print_api_layers();
+
+	// xrEnumerate*() functions are usually called once with CapacityInput = 0.
+	// The function will write the required amount into CountOutput. We then have
+	// to allocate an array to hold CountOutput elements and call the function
+	// with CountOutput as CapacityInput.
+	uint32_t ext_count = 0;
+	result = xrEnumerateInstanceExtensionProperties(NULL, 0, &ext_count, NULL);
+	if (XR_FAILED(result))
+	{
+		RLOPENXR_LOG_ERROR("Failed to enumerate number of extension properties. error code: %d", result);
+		return false;
+	}
+
+	std::vector<XrExtensionProperties> ext_props{ ext_count, { XR_TYPE_EXTENSION_PROPERTIES } };
+
+	result = xrEnumerateInstanceExtensionProperties(NULL, ext_count, &ext_count, &ext_props[0]);
+	if (XR_FAILED(result))
+	{
+		RLOPENXR_LOG_ERROR("Failed to enumerate number of extension properties. error code: %d", result);
+		return false;
+	}
+
+	bool opengl_supported = false;
+#if defined(RLOPENXR_PLATFORM_WIN32)
+	std::vector enabled_exts{ XR_KHR_OPENGL_ENABLE_EXTENSION_NAME, XR_EXT_DEBUG_UTILS_EXTENSION_NAME, XR_KHR_WIN32_CONVERT_PERFORMANCE_COUNTER_TIME_EXTENSION_NAME };
+#elif defined(RLOPENXR_PLATFORM_LINUX)
+	std::vector enabled_exts{ XR_EXT_DEBUG_UTILS_EXTENSION_NAME, XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME };
+
+	// Assume the calling thread is the one initialised by raylib. Raylib uses GLX through GLFW, but EGL contexts are supported too.
+	s_xr->linux_gl_binding = wrapped_GetCurrentGLBinding();
+	const char* gl_extension_name = nullptr;
+	switch (s_xr->linux_gl_binding)
+	{
+	case RLOPENXR_LINUX_GL_BINDING_XLIB: gl_extension_name = XR_KHR_OPENGL_ENABLE_EXTENSION_NAME; break;
+	case RLOPENXR_LINUX_GL_BINDING_EGL: gl_extension_name = XR_MNDX_EGL_ENABLE_EXTENSION_NAME; break;
+	default:
+		RLOPENXR_LOG_ERROR("rlOpenXR could not find a current GLX or EGL context. Call rlOpenXRSetup() after InitWindow().");
+		return false;
+	}
+	enabled_exts.push_back(gl_extension_name);
+#endif
+
+	RLOPENXR_LOG_DEBUG("Runtime supports %d extensions", ext_count);
+	for (uint32_t i = 0; i < ext_count; i++) {
+		RLOPENXR_LOG_DEBUG("\t%s v%d", ext_props[i].extensionName, ext_props[i].extensionVersion);
+
+		if (strcmp(XR_KHR_OPENGL_ENABLE_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
+			opengl_supported = true;
+		}
+
+		if (strcmp(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
+			s_xr->extensions.depth_enabled = true;
+			enabled_exts.push_back(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME);
+		}
+
+		if (strcmp(XR_EXT_HAND_TRACKING_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
+			s_xr->extensions.hand_tracking_enabled = true;
+			enabled_exts.push_back(XR_EXT_HAND_TRACKING_EXTENSION_NAME);
+		}
+
+#ifdef XR_KHR_locate_spaces
+		if (strcmp(XR_KHR_LOCATE_SPACES_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
+			enabled_exts.push_back(XR_KHR_LOCATE_SPACES_EXTENSION_NAME);
+		}
+#endif
+
+		if ((s_config.flags & RLOPENXR_FLAG_SPACE_WARP) && strcmp(XR_FB_SPACE_WARP_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
+			s_xr->extensions.space_warp_enabled = true;
+			enabled_exts.push_back(XR_FB_SPACE_WARP_EXTENSION_NAME);
+		}
+
+		if (strcmp(XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
+			s_xr->extensions.cylinder_enabled = true;
+			enabled_exts.push_back(XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME);
+		}
+
+		if (strcmp(XR_KHR_COMPOSITION_LAYER_EQUIRECT2_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
+			s_xr->extensions.equirect2_enabled = true;
+			enabled_exts.push_back(XR_KHR_COMPOSITION_LAYER_EQUIRECT2_EXTENSION_NAME);
+		}
+
+		if (strcmp(XR_MSFT_CONTROLLER_MODEL_EXTENSION_NAME, ext_props[i].extensionName) == 0) {
+			s_xr->extensions.controller_model_enabled = true;
+			enabled_exts.push_back(XR_MSFT_CONTROLLER_MODEL_EXTENSION_NAME);
+		}
+	}
+
+	if (!opengl_supported) 
+	{
+		RLOPENXR_LOG_ERROR("Runtime does not support OpenGL extension!");
+		return false;
+	}
+
+#if defined(RLOPENXR_PLATFORM_LINUX)
+	if (s_xr->linux_gl_binding == RLOPENXR_LINUX_GL_BINDING_EGL)
+	{
+		// XR_MNDX_egl_enable only provides the session binding, the swapchain images and requirements still come from XR_KHR_opengl_enable.
+		const bool egl_supported = std::any_of(ext_props.begin(), ext_props.end(), [](const XrExtensionProperties& props) {
+			return strcmp(XR_MNDX_EGL_ENABLE_EXTENSION_NAME, props.extensionName) == 0;
+		});
+		if (!egl_supported)
+		{
+			RLOPENXR_LOG_ERROR("Runtime does not support the EGL extension '%s'!", XR_MNDX_EGL_ENABLE_EXTENSION_NAME);
+			return false;
+		}
+		enabled_exts.push_back(XR_KHR_OPENGL_ENABLE_EXTENSION_NAME);
+	}
+#endif
+
+	// --- Create XrInstance
+	// same can be done for API layers, but API layers can also be enabled by env var
+
+	XrInstanceCreateInfo instance_create_info = {
+		.type = XR_TYPE_INSTANCE_CREATE_INFO,
+		.next = NULL,
+		.createFlags = 0,
+		.applicationInfo = {
+			.applicationVersion = 1,
+			.engineVersion = 0,
+			.apiVersion = XR_CURRENT_API_VERSION,
+		},
+		.enabledApiLayerCount = 0,
+		.enabledApiLayerNames = NULL,
+		.enabledExtensionCount = (uint32_t)enabled_exts.size(),
+		.enabledExtensionNames = enabled_exts.data(),
+	};
+	snprintf(instance_create_info.applicationInfo.applicationName, XR_MAX_APPLICATION_NAME_SIZE, "%s", "rlOpenXR Application"); // TODO: Do we want this to be exposed? Does it have any purpose?
+	snprintf(instance_create_info.applicationInfo.engineName, XR_MAX_ENGINE_NAME_SIZE, "%s", "Raylib (rlOpenXR)");
+
+	result = xrCreateInstance(&instance_create_info, &s_xr->data.instance);
+	if (!xr_check(result, "Failed to create XR instance."))
+		return false;
+
+	result = xrGetInstanceProcAddr(s_xr->data.instance, "xrGetOpenGLGraphicsRequirementsKHR",
+			(PFN_xrVoidFunction*)&s_xr->extensions.xrGetOpenGLGraphicsRequirementsKHR);
+	if (!xr_check(result, "Failed to get OpenGL graphics requirements function!"))
+		return false;
+
+#if defined(RLOPENXR_PLATFORM_WIN32)
+	result = xrGetInstanceProcAddr(s_xr->data.instance, "xrConvertWin32PerformanceCounterToTimeKHR",
+		(PFN_xrVoidFunction*)&s_xr->extensions.xrConvertWin32PerformanceCounterToTimeKHR);
+	if (!xr_check(result, "Failed to get xrConvertWin32PerformanceCounterToTimeKHR function!"))
+		return false;
+#elif defined(RLOPENXR_PLATFORM_LINUX)
+	result = xrGetInstanceProcAddr(s_xr->data.instance, "xrConvertTimespecTimeToTimeKHR",
+		(PFN_xrVoidFunction*)&s_xr->extensions.xrConvertTimespecTimeToTimeKHR);
+	if (!xr_check(result, "Failed to get xrConvertTimespecTimeToTimeKHR function!"))
+		return false;
+#endif
+
+#ifdef XR_KHR_locate_spaces
+	if (std::find_if(enabled_exts.begin(), enabled_exts.end(), [](const char* name) { return strcmp(name, XR_KHR_LOCATE_SPACES_EXTENSION_NAME) == 0; }) != enabled_exts.end())
+	{
+		result = xrGetInstanceProcAddr(s_xr->data.instance, "xrLocateSpacesKHR",
+			(PFN_xrVoidFunction*)&s_xr->extensions.xrLocateSpacesKHR);
+		if (!xr_check(result, "Failed to get xrLocateSpacesKHR function, locating spaces one by one"))
+			s_xr->extensions.xrLocateSpacesKHR = nullptr;
+	}
+#endif
+
+	if (s_xr->extensions.hand_tracking_enabled)
+	{
+		const bool loaded =
+			XR_SUCCEEDED(xrGetInstanceProcAddr(s_xr->data.instance, "xrCreateHandTrackerEXT", (PFN_xrVoidFunction*)&s_xr->extensions.xrCreateHandTrackerEXT)) &&
+			XR_SUCCEEDED(xrGetInstanceProcAddr(s_xr->data.instance, "xrDestroyHandTrackerEXT", (PFN_xrVoidFunction*)&s_xr->extensions.xrDestroyHandTrackerEXT)) &&
+			XR_SUCCEEDED(xrGetInstanceProcAddr(s_xr->data.instance, "xrLocateHandJointsEXT", (PFN_xrVoidFunction*)&s_xr->extensions.xrLocateHandJointsEXT));
+		if (!loaded)
+		{
+			RLOPENXR_LOG_WARNING("Failed to get the XR_EXT_hand_tracking functions, disabling hand tracking");
+			s_xr->extensions.hand_tracking_enabled = false;
+		}
+	}
+
+	if (s_xr->extensions.controller_model_enabled)
+	{
+		const bool loaded =
+			XR_SUCCEEDED(xrGetInstanceProcAddr(s_xr->data.instance, "xrGetControllerModelKeyMSFT", (PFN_xrVoidFunction*)&s_xr->extensions.xrGetControllerModelKeyMSFT)) &&
+			XR_SUCCEEDED(xrGetInstanceProcAddr(s_xr->data.instance, "xrLoadControllerModelMSFT", (PFN_xrVoidFunction*)&s_xr->extensions.xrLoadControllerModelMSFT));
+		if (!loaded)
+		{
+			RLOPENXR_LOG_WARNING("Failed to get the XR_MSFT_controller_model functions, disabling controller models");
+			s_xr->extensions.controller_model_enabled = false;
+		}
+	}
+
+	result = xrGetInstanceProcAddr(s_xr->data.instance, "xrCreateDebugUtilsMessengerEXT",
+			(PFN_xrVoidFunction*)&s_xr->extensions.xrCreateDebugUtilsMessengerEXT);
+	if (!xr_check(result, "Failed to get xrCreateDebugUtilsMessengerEXT function!"))
+		return false;
+
+	result = xrGetInstanceProcAddr(s_xr->data.instance, "xrDestroyDebugUtilsMessengerEXT",
+			(PFN_xrVoidFunction*)&s_xr->extensions.xrDestroyDebugUtilsMessengerEXT);
+	if (!xr_check(result, "Failed to get xrDestroyDebugUtilsMessengerEXT function!"))
+		return false;
+
+	// Without any severity to report there is no messenger at all
+	const XrDebugUtilsMessageSeverityFlagsEXT debug_message_severities = debug_messenger_severities();
+	if (debug_message_severities != 0)
+	{
+		XrDebugUtilsMessengerCreateInfoEXT debug_message_create_info{
+			.type = XR_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT,
+			.next = nullptr,
+			.messageSeverities = debug_message_severities,
+			.messageTypes = XR_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_CONFORMANCE_BIT_EXT,
+			.userCallback = &debug_messenger_callback,
+			.userData = nullptr
+		};
+
+		result = s_xr->extensions.xrCreateDebugUtilsMessengerEXT(s_xr->data.instance, &debug_message_create_info, &s_xr->extensions.debug_messenger_handle);
+		if (!xr_check(result, "Failed create debug messenger!"))
+			return false;
+	}
+
+	// Optionally get runtime name and version
+	print_instance_properties(s_xr->data.instance);
+
+	// --- Get XrSystemId
+	XrSystemGetInfo system_get_info = {
+		.type = XR_TYPE_SYSTEM_GET_INFO, .next = NULL, .formFactor = c_form_factor };
+
+	result = xrGetSystem(s_xr->data.instance, &system_get_info, &s_xr->data.system_id);
+	if (!xr_check(result, "Failed to get system for HMD form factor."))
+		return false;
+
+	RLOPENXR_LOG_INFO("Successfully got XrSystem with id %llu for HMD form factor", (unsigned long long)s_xr->data.system_id);
+
+	{
+		XrSystemSpaceWarpPropertiesFB space_warp_props{ XR_TYPE_SYSTEM_SPACE_WARP_PROPERTIES_FB };
+		XrSystemHandTrackingPropertiesEXT hand_tracking_props{ XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_EXT };
+		XrSystemProperties system_props = { .type = XR_TYPE_SYSTEM_PROPERTIES };
+
+		if (s_xr->extensions.space_warp_enabled)
+		{
+			space_warp_props.next = system_props.next;
+			system_props.next = &space_warp_props;
+		}
+		if (s_xr->extensions.hand_tracking_enabled)
+		{
+			hand_tracking_props.next = system_props.next;
+			system_props.next = &hand_tracking_props;
+		}
+
+		result = xrGetSystemProperties(s_xr->data.instance, s_xr->data.system_id, &system_props);
+		if (!xr_check(result, "Failed to get System properties"))
+			return false;
+
+		print_system_properties(&system_props);
+
+		s_xr->max_layer_count = std::max(system_props.graphicsProperties.maxLayerCount, 1u);
+
+		// The extension can be there without a system that tracks hands
+		s_xr->extensions.hand_tracking_enabled = s_xr->extensions.hand_tracking_enabled && hand_tracking_props.supportsHandTracking;
+
+		s_xr->space_warp.view_extent = XrExtent2Di{ (int32_t)space_warp_props.recommendedMotionVectorImageRectWidth, (int32_t)space_warp_props.recommendedMotionVectorImageRectHeight };
+		s_xr->extensions.space_warp_enabled = s_xr->extensions.space_warp_enabled && s_xr->space_warp.view_extent.width > 0 && s_xr->space_warp.view_extent.height > 0;
+	}
+
+	if ((s_config.flags & RLOPENXR_FLAG_SPACE_WARP) && !s_xr->extensions.space_warp_enabled)
+	{
+		RLOPENXR_LOG_WARNING("rlOpenXR: The runtime does not support XR_FB_space_warp, rendering at the full frame rate.");
+	}
+
+	uint32_t view_count;
+	result = xrEnumerateViewConfigurationViews(s_xr->data.instance, s_xr->data.system_id, c_view_type, 0, &view_count, NULL);
+	if (!xr_check(result, "Failed to get view configuration view count!"))
+		return false;
+
+	s_xr->viewconfig_views.resize(view_count, XrViewConfigurationView{ .type = XR_TYPE_VIEW_CONFIGURATION_VIEW , .next = nullptr });
+	
+	result = xrEnumerateViewConfigurationViews(s_xr->data.instance, s_xr->data.system_id, c_view_type, view_count,
+		&view_count, &s_xr->viewconfig_views[0]);
+	if (!xr_check(result, "Failed to enumerate view configuration views!"))
+		return false;
+	print_viewconfig_view_info(view_count, &s_xr->viewconfig_views[0]);
+
+
+	// this function pointer was loaded with xrGetInstanceProcAddr
+	// OpenXR requires checking graphics requirements before creating a session.
+	XrGraphicsRequirementsOpenGLKHR opengl_reqs = { .type = XR_TYPE_GRAPHICS_REQUIREMENTS_OPENGL_KHR,
+												   .next = NULL };
+
+
+	result = s_xr->extensions.xrGetOpenGLGraphicsRequirementsKHR(s_xr->data.instance, s_xr->data.system_id, &opengl_reqs);
+	if (!xr_check(result, "Failed to get OpenGL graphics requirements!"))
+		return false;
+
+	auto min_major = XR_VERSION_MAJOR(opengl_reqs.minApiVersionSupported);
+	auto min_minor = XR_VERSION_MINOR(opengl_reqs.minApiVersionSupported);
+	auto min_patch = XR_VERSION_PATCH(opengl_reqs.minApiVersionSupported);
+
+	auto max_major = XR_VERSION_MAJOR(opengl_reqs.maxApiVersionSupported);
+	auto max_minor = XR_VERSION_MINOR(opengl_reqs.maxApiVersionSupported);
+	auto max_patch = XR_VERSION_PATCH(opengl_reqs.maxApiVersionSupported);
+
+	int major, minor;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+	RLOPENXR_LOG_INFO("OpenXR OpenGL requirements, min: %d.%d.%d, max: %d.%d.%d, got: %d.%d", 
+		min_major, min_minor, min_patch,
+		max_major, max_minor, max_patch,
+		major, minor
+		);
+
+	if (s_config.flags & RLOPENXR_FLAG_MULTIVIEW)
+	{
+		s_xr->multiview = multiview_load();
+	}
+	if (!s_xr->multiview)
+	{
+		instanced_stereo_load();
+	}
+
+	// --- Create session
+	// Assume the calling thread is the one initialised by raylib
+#if defined(RLOPENXR_PLATFORM_WIN32)
+	auto graphics_binding_gl = XrGraphicsBindingOpenGLWin32KHR{
+		.type = XR_TYPE_GRAPHICS_BINDING_OPENGL_WIN32_KHR,
+		.next = nullptr,
+		.hDC = wrapped_wglGetCurrentDC(),
+		.hGLRC = wrapped_wglGetCurrentContext()
+	};
+
+	assert(graphics_binding_gl.hDC != NULL);
+	assert(graphics_binding_gl.hGLRC != NULL);
+
+	const void* graphics_binding = &graphics_binding_gl;
+#elif defined(RLOPENXR_PLATFORM_LINUX)
+	const void* graphics_binding = wrapped_XrGraphicsBindingFromCurrentContext(s_xr->linux_gl_binding);
+	if (graphics_binding == nullptr)
+	{
+		RLOPENXR_LOG_ERROR("rlOpenXR failed to query the GL config of the current context.");
+		return false;
+	}
+#endif
+
+	XrSessionCreateInfo session_create_info = {
+		.type = XR_TYPE_SESSION_CREATE_INFO, .next = graphics_binding, .systemId = s_xr->data.system_id };
+
+	result = xrCreateSession(s_xr->data.instance, &session_create_info, &s_xr->data.session);
+	if (!xr_check(result, "Failed to create session"))
+		return false;
+
+	RLOPENXR_LOG_INFO("Successfully created a session with OpenGL!");
+
+	hand_tracking_load();
+
+	/* Many runtimes support at least STAGE and LOCAL but not all do.
+	 * Sophisticated apps might check with xrEnumerateReferenceSpaces() if the
+	 * chosen one is supported and try another one if not.
+	 * Here we will get an error from xrCreateReferenceSpace() and exit. */
+	XrReferenceSpaceCreateInfo play_space_create_info = { .type = XR_TYPE_REFERENCE_SPACE_CREATE_INFO,
+														 .next = NULL,
+														 .referenceSpaceType = c_play_space_type,
+														 .poseInReferenceSpace = identity_pose };
+
+	result = xrCreateReferenceSpace(s_xr->data.session, &play_space_create_info, &s_xr->data.play_space);
+	if (!xr_check(result, "Failed to create play space!"))
+		return false;
+
+	XrReferenceSpaceCreateInfo view_space_create_info = { .type = XR_TYPE_REFERENCE_SPACE_CREATE_INFO,
+													 .next = NULL,
+													 .referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW,
+													 .poseInReferenceSpace = identity_pose };
+
+	result = xrCreateReferenceSpace(s_xr->data.session, &view_space_create_info, &s_xr->data.view_space);
+	if (!xr_check(result, "Failed to create view space!"))
+		return false;
+
+	// --- Create Swapchains
+	uint32_t supported_gl_internal_format_count;
+	result = xrEnumerateSwapchainFormats(s_xr->data.session, 0, &supported_gl_internal_format_count, NULL);
+	if (!xr_check(result, "Failed to get number of supported swapchain formats"))
+		return false;
+
+	RLOPENXR_LOG_DEBUG("Runtime supports %d swapchain formats", supported_gl_internal_format_count);
+
+	std::vector<int64_t> supported_gl_internal_formats;
+	supported_gl_internal_formats.resize(supported_gl_internal_format_count);
+	result = xrEnumerateSwapchainFormats(s_xr->data.session, supported_gl_internal_format_count, &supported_gl_internal_format_count,
+		&supported_gl_internal_formats[0]);
+	if (!xr_check(result, "Failed to enumerate swapchain formats"))
+		return false;
+
+	// TODO: assert recommendedSwapchainSampleCounts & recommendedImageRectHeights are the same for each view
+	// With dynamic resolution the swapchains are allocated at the max scale, and each frame renders into a part of them.
+	const bool dynamic_resolution = s_config.flags & RLOPENXR_FLAG_DYNAMIC_RESOLUTION;
+	const float max_resolution_scale = dynamic_resolution ? s_config.resolution_scale_max : 1.f;
+	const auto& first_view = s_xr->viewconfig_views[0];
+	s_xr->swapchain_view_extent = XrExtent2Di{
+		(int32_t)std::min((uint32_t)lroundf(first_view.recommendedImageRectWidth * max_resolution_scale), first_view.maxImageRectWidth),
+		(int32_t)std::min((uint32_t)lroundf(first_view.recommendedImageRectHeight * max_resolution_scale), first_view.maxImageRectHeight)
+	};
+	s_xr->resolution_scale = dynamic_resolution ? std::clamp(1.f, s_config.resolution_scale_min, s_config.resolution_scale_max) : 1.f;
+
+	// Views are side by side, or with multiview a layer each
+	const uint32_t swapchain_width = (uint32_t)s_xr->swapchain_view_extent.width * (s_xr->multiview ? 1 : view_count);
+	const uint32_t swapchain_height = (uint32_t)s_xr->swapchain_view_extent.height;
+	const uint32_t swapchain_array_size = s_xr->multiview ? view_count : 1;
+
+	// Pick the most preferred formats the runtime supports, see rlOpenXRSetSwapchainColorFormats()
+	s_xr->color_format = negotiate_swapchain_format(s_config.color_formats, supported_gl_internal_formats);
+	if (s_xr->color_format == 0)
+	{
+		RLOPENXR_LOG_ERROR("rlOpenXR none of the %d preferred color formats are supported by this OpenXR driver.", (int)s_config.color_formats.size());
+		return false;
+	}
+	const int64_t color_gl_internal_format = s_xr->color_format;
+	const char* color_format_name = gl_format_name(color_gl_internal_format);
+
+	if (s_xr->extensions.depth_enabled)
+	{
+		s_xr->depth_format = negotiate_swapchain_format(s_config.depth_formats, supported_gl_internal_formats);
+		if (s_xr->depth_format == 0)
+		{
+			RLOPENXR_LOG_WARNING("rlOpenXR none of the %d preferred depth formats are supported by this OpenXR driver. Disabling depth", (int)s_config.depth_formats.size());
+			s_xr->extensions.depth_enabled = false;
+		}
+	}
+	const int64_t depth_gl_internal_format = s_xr->depth_format;
+	const char* depth_format_name = gl_format_name(depth_gl_internal_format);
+
+	// --- Create swapchain for main VR rendering
+	{
+		// In the frame loop we render into OpenGL textures we receive from the runtime here.
+		XrSwapchainCreateInfo swapchain_create_info = {
+			.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
+			.next = NULL,
+			.createFlags = 0,
+			.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT,
+			.format = color_gl_internal_format,
+			//TODO: Get multisampling enabled from the Raylib hint
+			.sampleCount = s_xr->viewconfig_views[0].recommendedSwapchainSampleCount,
+			.width = swapchain_width,
+			.height = swapchain_height,
+			.faceCount = 1,
+			.arraySize = swapchain_array_size,
+			.mipCount = 1,
+		};
+
+		result = xrCreateSwapchain(s_xr->data.session, &swapchain_create_info, &s_xr->swapchain);
+		if (!xr_check(result, "Failed to create swapchain!"))
+			return false;
+
+		// The runtime controls how many textures we have to be able to render to
+		// (e.g. "triple buffering")
+		uint32_t swapchain_image_count;
+		result = xrEnumerateSwapchainImages(s_xr->swapchain, 0, &swapchain_image_count, NULL);
+		if (!xr_check(result, "Failed to enumerate swapchains"))
+			return false;
+
+		s_xr->swapchain_images.resize(swapchain_image_count, { .type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR, .next = nullptr });
+		result = xrEnumerateSwapchainImages(s_xr->swapchain, swapchain_image_count, &swapchain_image_count,
+				(XrSwapchainImageBaseHeader*)s_xr->swapchain_images.data());
+		if (!xr_check(result, "Failed to enumerate swapchain images"))
+			return false;
+
+		RLOPENXR_LOG_INFO("Succesfully created OpenXR color swapchain with format: %s. Dimensions: %d, %d", 
+			color_format_name, swapchain_create_info.width, swapchain_create_info.height);
+	}
+
+	// --- Create swapchain for depth buffers if supported
+	{
+		if (s_xr->extensions.depth_enabled) {
+
+			XrSwapchainCreateInfo swapchain_create_info = {
+				.type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
+				.next = NULL,
+				.createFlags = 0,
+				.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+				.format = depth_gl_internal_format,
+				.sampleCount = s_xr->viewconfig_views[0].recommendedSwapchainSampleCount,
+				.width = swapchain_width,
+				.height = swapchain_height,
+				.faceCount = 1,
+				.arraySize = swapchain_array_size,
+				.mipCount = 1,
+			};
+
+			result = xrCreateSwapchain(s_xr->data.session, &swapchain_create_info, &s_xr->depth_swapchain);
+			if (!xr_check(result, "Failed to create swapchain!"))
+				return false;
+
+			uint32_t depth_swapchain_image_count;
+			result = xrEnumerateSwapchainImages(s_xr->depth_swapchain, 0, &depth_swapchain_image_count, NULL);
+			if (!xr_check(result, "Failed to enumerate swapchains"))
+				return false;
+
+			// these are wrappers for the actual OpenGL texture id
+			s_xr->depth_swapchain_images.resize(depth_swapchain_image_count, {.type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR, .next = nullptr});
+			result = xrEnumerateSwapchainImages(s_xr->depth_swapchain, depth_swapchain_image_count, &depth_swapchain_image_count,
+				(XrSwapchainImageBaseHeader*)s_xr->depth_swapchain_images.data());
+			if (!xr_check(result, "Failed to enumerate swapchain images"))
+				return false;
+
+			RLOPENXR_LOG_INFO("Succesfully created OpenXR depth swapchain with format: %s. Dimensions: %d, %d",
+				depth_format_name, swapchain_create_info.width, swapchain_create_info.height);
+		}
+	}
+
+
+	if (!create_swapchain_framebuffers(swapchain_width, swapchain_height))
+		return false;
+
+	// Do not allocate these every frame to save some resources
+	s_xr->views.resize(view_count, { .type = XR_TYPE_VIEW, .next = nullptr });
+
+	s_xr->projection_views.resize(view_count);
+	for (uint32_t view = 0; view < view_count; view++) {
+		s_xr->projection_views[view].type = XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW;
+		s_xr->projection_views[view].next = NULL;
+
+		s_xr->projection_views[view].subImage.swapchain = s_xr->swapchain;
+		s_xr->projection_views[view].subImage.imageArrayIndex = s_xr->multiview ? view : 0;
+
+		// projection_views[i].{pose, fov} have to be filled every frame in frame loop
+	};
+
+
+	if (s_xr->extensions.depth_enabled) {
+		s_xr->depth_infos.resize(view_count);
+		for (uint32_t view = 0; view < view_count; view++) {
+			s_xr->depth_infos[view].type = XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR;
+			s_xr->depth_infos[view].next = NULL;
+			s_xr->depth_infos[view].minDepth = 0.f;
+			s_xr->depth_infos[view].maxDepth = 1.f;
+			s_xr->depth_infos[view].nearZ = (float)RL_CULL_DISTANCE_NEAR;
+			s_xr->depth_infos[view].farZ = (float)RL_CULL_DISTANCE_FAR;
+
+			s_xr->depth_infos[view].subImage.swapchain = s_xr->depth_swapchain;
+			s_xr->depth_infos[view].subImage.imageArrayIndex = s_xr->multiview ? view : 0;
+
+			// depth is chained to projection, not submitted as separate layer
+			s_xr->projection_views[view].next = &s_xr->depth_infos[view];
+		};
+	}
+
+	if (s_xr->extensions.space_warp_enabled)
+	{
+		s_xr->space_warp.loaded = space_warp_load(supported_gl_internal_formats);
+		s_xr->space_warp.active = s_xr->space_warp.loaded;
+	}
+
+	// imageRects follow the resolution scale, they are updated every frame in rlOpenXRBegin()
+	update_view_rects();
+
+	s_xr->layer_projection.layerFlags = 0;
+	s_xr->layer_projection.space = s_xr->data.play_space;
+	s_xr->layer_projection.viewCount = view_count;
+	s_xr->layer_projection.views = s_xr->projection_views.data();
+	update_layers_pointers();
+
+	gpu_timers_load();
+
+	// Last, nothing can fail after it, so a failed setup never leaves the loader thread running
+	start_controller_model_thread();
+
+	return true;
+}
+
+// Everything setup() creates, in reverse. Also runs when setup() failed part way, so every step skips what was never created.
+static void teardown()
+{
+	stop_frame_wait_thread();
+	controller_models_unload();
+	hand_tracking_unload();
+	gpu_timers_unload();
+	multiview_unload();
+	instanced_stereo_unload();
+	space_warp_unload();
+	for (RLOpenXRLayer& layer : s_xr->layers)
+	{
+		destroy_layer(layer);
+	}
+	destroy_swapchain_framebuffers();
+	UnloadRenderTexture(s_xr->mock_hmd_rt);
+
+	if (s_xr->extensions.debug_messenger_handle != XR_NULL_HANDLE)
+	{
+		s_xr->extensions.xrDestroyDebugUtilsMessengerEXT(s_xr->extensions.debug_messenger_handle);
+	}
+
+	if (s_xr->data.instance != XR_NULL_HANDLE)
+	{
+		XrResult result = xrDestroyInstance(s_xr->data.instance);
+		if (XR_SUCCEEDED(result))
+		{
+			RLOPENXR_LOG_INFO("Succesfully shutdown OpenXR.");
+		}
+		else
+		{
+			RLOPENXR_LOG_ERROR("Failed to shutdown OpenXR. error code: %d", result);
+		}
+	}
+
+	// The runtime can still use the GL context while destroying the swapchains, so the context goes last.
+	if (s_xr->headless)
+	{
+		rlglClose();
+#if defined(RLOPENXR_PLATFORM_LINUX)
+		wrapped_eglDestroyHeadlessContext();
+#endif
+	}
+
+	s_xr.reset();
+
+	stop_log_thread();
+}
+
+bool rlOpenXRSetup()
+{
+	if (setup())
+		return true;
+
+	// Nothing of a failed setup is kept, so rlOpenXRShutdown() isn't needed and rlOpenXRSetup() can be called again
+	teardown();
+	return false;
+}
+
+void rlOpenXRShutdown()
+{
+	if (!s_xr)
+	{
+		RLOPENXR_LOG_ERROR("rlOpenXR it not valid! Aborting openXR shutdown");
+		return;
+	}
+
+	stop_frame_wait_thread();
+
+	if (!s_config.frame_stats_dump_path.empty())
+	{
+		frame_stats_dump(s_config.frame_stats_dump_path.c_str());
+	}
+
+	teardown();
+}
+
+// ----------------------------------------------------------------------------
+
+void rlOpenXRUpdate()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+
+	invalidate_frame_cache();
+
+	XrResult result;
+
+	// Poll OpenXR Events
+	XrEventDataBuffer runtime_event = { .type = XR_TYPE_EVENT_DATA_BUFFER, .next = NULL };
+	XrResult poll_result = xrPollEvent(s_xr->data.instance, &runtime_event);
+	const bool had_events = poll_result == XR_SUCCESS;
+	while (poll_result == XR_SUCCESS) {
+		switch (runtime_event.type) {
+		case XR_TYPE_EVENT_DATA_EVENTS_LOST: {
+			XrEventDataEventsLost* event = (XrEventDataEventsLost*)&runtime_event;
+			push_event(RLOpenXREvent{ .type = RLOPENXR_EVENT_EVENTS_LOST, .lost_event_count = event->lostEventCount });
+
+			break;
+		}
+		case XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING: {
+			// The app has to call rlOpenXRShutdown(), until then there is nothing to render to
+			XrEventDataInstanceLossPending* event = (XrEventDataInstanceLossPending*)&runtime_event;
+			s_xr->run_framecycle = false;
+			push_event(RLOpenXREvent{ .type = RLOPENXR_EVENT_INSTANCE_LOSS_PENDING, .time = event->lossTime });
+
+			break;
+		}
+		case XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING: {
+			XrEventDataReferenceSpaceChangePending* event = (XrEventDataReferenceSpaceChangePending*)&runtime_event;
+			const XrPosef& pose = event->poseInPreviousSpace;
+			push_event(RLOpenXREvent{
+				.type = RLOPENXR_EVENT_REFERENCE_SPACE_CHANGE_PENDING,
+				.time = event->changeTime,
+				.reference_space_type = event->referenceSpaceType,
+				.pose_valid = event->poseValid == XR_TRUE,
+				.position = Vector3{ pose.position.x, pose.position.y, pose.position.z },
+				.orientation = Quaternion{ pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w }
+			});
+
+			break;
+		}
+		case XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED: {
+			XrEventDataSessionStateChanged* event = (XrEventDataSessionStateChanged*)&runtime_event;
+			const XrSessionState previous_state = s_xr->data.session_state;
+			s_xr->data.session_state = event->state;
+
+			push_event(RLOpenXREvent{
+				.type = RLOPENXR_EVENT_SESSION_STATE_CHANGED,
+				.time = event->time,
+				.session_state = event->state,
+				.previous_session_state = previous_state
+			});
+
+			const bool visible = is_session_visible(event->state);
+			const bool focused = event->state == XR_SESSION_STATE_FOCUSED;
+			if (visible != is_session_visible(previous_state) || focused != (previous_state == XR_SESSION_STATE_FOCUSED))
+			{
+				push_event(RLOpenXREvent{
+					.type = RLOPENXR_EVENT_VISIBILITY_CHANGED,
+					.time = event->time,
+					.session_state = event->state,
+					.previous_session_state = previous_state,
+					.visible = visible,
+					.focused = focused
+				});
+			}
+
+			/*
+			 * react to session state changes, see OpenXR spec 9.3 diagram. What we need to react to:
+			 *
+			 * * READY -> xrBeginSession STOPPING -> xrEndSession (note that the same session can be restarted)
+			 * * EXITING -> xrDestroySession (EXITING only happens after we went through STOPPING and called xrEndSession)
+			 *
+			 * After exiting it is still possible to create a new session but we don't do that here.
+			 *
+			 * * IDLE -> don't run render loop, but keep polling for events
+			 * * SYNCHRONIZED, VISIBLE, FOCUSED -> run render loop
+			 */
+			switch (s_xr->data.session_state) {
+				// skip render loop, keep polling
+			case XR_SESSION_STATE_MAX_ENUM: // must be a bug
+			case XR_SESSION_STATE_IDLE:
+			case XR_SESSION_STATE_UNKNOWN: {
+				s_xr->run_framecycle = false;
+
+				break; // state handling switch
+			}
+
+										 // do nothing, run render loop normally
+			case XR_SESSION_STATE_FOCUSED:
+			case XR_SESSION_STATE_SYNCHRONIZED:
+			case XR_SESSION_STATE_VISIBLE: {
+				s_xr->run_framecycle = true;
+
+				break; // state handling switch
+			}
+
+										 // begin session and then run render loop
+			case XR_SESSION_STATE_READY: {
+				// start session only if it is not running, i.e. not when we already called xrBeginSession
+				// but the runtime did not switch to the next state yet
+				if (!s_xr->session_running) {
+					XrSessionBeginInfo session_begin_info = { .type = XR_TYPE_SESSION_BEGIN_INFO,
+															 .next = NULL,
+															 .primaryViewConfigurationType = c_view_type };
+					result = xrBeginSession(s_xr->data.session, &session_begin_info);
+					if (!xr_check(result, "Failed to begin session!"))
+						return;
+					RLOPENXR_LOG_INFO("Session started!");
+					s_xr->session_running = true;
+					s_xr->frame_begun = false;
+					s_xr->controller_model_keys_dirty = true;
+
+					if (s_config.flags & RLOPENXR_FLAG_PIPELINED_WAIT_FRAME)
+					{
+						start_frame_wait_thread();
+					}
+				}
+				// after beginning the session, run render loop
+				s_xr->run_framecycle = true;
+
+				break; // state handling switch
+			}
+
+									   // end session, skip render loop, keep polling for next state change
+			case XR_SESSION_STATE_STOPPING: {
+				// end session only if it is running, i.e. not when we already called xrEndSession but the
+				// runtime did not switch to the next state yet
+				if (s_xr->session_running) {
+					stop_frame_wait_thread();
+
+					result = xrEndSession(s_xr->data.session);
+					if (!xr_check(result, "Failed to end session!"))
+						return;
+					s_xr->session_running = false;
+				}
+				// after ending the session, don't run render loop
+				s_xr->run_framecycle = false;
+
+				break; // state handling switch
+			}
+
+										  // destroy session, skip render loop, exit render loop and quit
+			case XR_SESSION_STATE_LOSS_PENDING:
+			case XR_SESSION_STATE_EXITING:
+				stop_frame_wait_thread();
+				stop_controller_model_thread();
+
+				result = xrDestroySession(s_xr->data.session);
+				if (!xr_check(result, "Failed to destroy session!"))
+					return;
+				s_xr->run_framecycle = false;
+
+				break; // state handling switch
+			}
+			break; // session event handling switch
+		}
+		case XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED: {
+			// A different controller can have a different model
+			s_xr->controller_model_keys_dirty = true;
+			push_event(RLOpenXREvent{ .type = RLOPENXR_EVENT_INTERACTION_PROFILE_CHANGED });
+
+			break;
+		}
+		default: break; // Events of extensions rlOpenXR does not handle
+		}
+
+		runtime_event.type = XR_TYPE_EVENT_DATA_BUFFER;
+		poll_result = xrPollEvent(s_xr->data.instance, &runtime_event);
+	}
+	if (poll_result != XR_EVENT_UNAVAILABLE) {
+		xr_check(poll_result, "Failed to poll events!");
+	}
+
+	// Uploads happen before the wait, in time the frame loop would otherwise spend blocked
+	controller_models_update();
+
+	// Wait for OpenXR frame
+	if (s_xr->frame_waiter.thread.joinable())
+	{
+		// Pipelined: take the frame if the wait thread already has it, otherwise rlOpenXRBegin() waits for it
+		if (!s_xr->pipelined_frame_acquired)
+		{
+			s_xr->pipelined_frame_acquired = acquire_pipelined_frame_state(false);
+		}
+	}
+	else if (!s_xr->session_running)
+	{
+		// Nothing paces the loop without xrWaitFrame(). Events that arrived this update are handled first, a READY state begins the session right away.
+		if (!had_events && s_config.idle_sleep_ms > 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(s_config.idle_sleep_ms));
+		}
+	}
+	else
+	{
+		XrFrameWaitInfo frame_wait_info = { .type = XR_TYPE_FRAME_WAIT_INFO, .next = NULL };
+		const int64_t wait_start = steady_time_ns();
+		result = xrWaitFrame(s_xr->data.session, &frame_wait_info, &s_xr->frame_state);
+		if (!xr_check(result, "xrWaitFrame() was not successful, skipping this frame"))
+		{
+			return;
+		}
+		frame_stats_record_wait(s_xr->frame_state, steady_time_ns() - wait_start);
+	}
+
+	sync_managed_actions();
+}
+
+void rlOpenXRUpdateCamera(Camera3D* camera)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(camera != nullptr);
+
+	s_xr->camera_fovy = camera->fovy;
+	s_xr->camera_projection = camera->projection;
+
+	const XrTime time = rlOpenXRGetTime();
+
+	XrSpaceLocation view_location{ XR_TYPE_SPACE_LOCATION };
+	XrResult result = locate_space_cached(s_xr->data.view_space, s_xr->data.play_space, time, &view_location);
+	if (!xr_check(result, "Could not locate view location"))
+	{
+		return;
+	}
+
+	if (view_location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)
+	{
+		const auto& pos = view_location.pose.position;
+		camera->position = Vector3{ pos.x, pos.y, pos.z };
+	}
+	if (view_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)
+	{
+		const auto& rot = view_location.pose.orientation;
+		const auto forward = Vector3RotateByQuaternion(Vector3{ 0, 0, -1 }, Quaternion{ rot.x, rot.y, rot.z, rot.w });
+		const auto up = Vector3RotateByQuaternion(Vector3{ 0, 1, 0 }, Quaternion{ rot.x, rot.y, rot.z, rot.w });
+		camera->target = Vector3Add(camera->position, forward);
+		camera->up = up;
+	}
+}
+
+void rlOpenXRUpdateCameraTransform(Transform* transform)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(transform != nullptr);
+
+	const XrTime time = rlOpenXRGetTime();
+
+	XrSpaceLocation view_location{ XR_TYPE_SPACE_LOCATION };
+	XrResult result = locate_space_cached(s_xr->data.view_space, s_xr->data.play_space, time, &view_location);
+	if (!xr_check(result, "Could not locate view location"))
+	{
+		return;
+	}
+
+	if (view_location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)
+	{
+		const auto& pos = view_location.pose.position;
+		transform->translation = Vector3{ pos.x, pos.y, pos.z };
+	}
+	if (view_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)
+	{
+		const auto& rot = view_location.pose.orientation;
+		transform->rotation = Quaternion{ rot.x, rot.y, rot.z, rot.w };
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+bool rlOpenXRBegin()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+
+	if (!s_xr->session_running)
+	{
+		return false;
+	}
+
+	if (s_xr->frame_waiter.thread.joinable())
+	{
+		const bool acquired = s_xr->pipelined_frame_acquired || acquire_pipelined_frame_state(true);
+		s_xr->pipelined_frame_acquired = false;
+		if (!acquired)
+		{
+			return false;
+		}
+	}
+
+	// After the pipelined wait, so begin_to_end_ns does not include time blocked on the runtime
+	s_xr->frame_stats.begin_time_ns = steady_time_ns();
+
+	// Begin right after the wait, so every frame state that was waited on is also begun. A failure from here on
+	// still lets rlOpenXREnd() end the frame without layers, instead of stalling the next xrWaitFrame().
+	XrFrameBeginInfo frame_begin_info = { XR_TYPE_FRAME_BEGIN_INFO };
+	XrResult result = xrBeginFrame(s_xr->data.session, &frame_begin_info);
+	if (!xr_check(result, "failed to begin frame!"))
+		return false;
+	s_xr->frame_begun = true;
+
+	// The frame is still ended by rlOpenXREnd(), without any layers
+	if (!s_xr->run_framecycle || !s_xr->frame_state.shouldRender)
+	{
+		return false;
+	}
+
+	uint32_t swapchain_image_index = std::numeric_limits<uint32_t>::max();
+	XrSwapchainImageAcquireInfo color_swapchain_image_acquire_info{ XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO };
+	result = xrAcquireSwapchainImage(s_xr->swapchain, &color_swapchain_image_acquire_info, &swapchain_image_index);
+	if (!xr_check(result, "failed to aquire swapchain image!"))
+		return false;
+	XrSwapchainImageWaitInfo wait_info{ XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
+	wait_info.timeout = XR_INFINITE_DURATION;
+	result = xrWaitSwapchainImage(s_xr->swapchain, &wait_info);
+	if (!xr_check(result, "failed to wait for swapchain image!"))
+		return false;
+
+	uint32_t color_swapchain_image = s_xr->swapchain_images[swapchain_image_index].image;
+	uint32_t depth_swapchain_image = std::numeric_limits<uint32_t>::max();
+	uint32_t swapchain_depth_image_index = 0;
+
+	if (s_xr->extensions.depth_enabled)
+	{
+		XrSwapchainImageAcquireInfo depth_swapchain_image_acquire_info{ XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO };
+		result = xrAcquireSwapchainImage(s_xr->depth_swapchain, &depth_swapchain_image_acquire_info, &swapchain_depth_image_index);
+		XrSwapchainImageWaitInfo depth_wait_info{ XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
+		depth_wait_info.timeout = XR_INFINITE_DURATION;
+		if (!xr_check(result, "failed to aquire swapchain depth image!") ||
+			!xr_check(xrWaitSwapchainImage(s_xr->depth_swapchain, &depth_wait_info), "failed to wait for swapchain depth image!"))
+		{
+			// rlOpenXREnd() only releases the images of a rendered frame, the color image would stay acquired forever
+			XrSwapchainImageReleaseInfo release_info{ XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
+			xrReleaseSwapchainImage(s_xr->swapchain, &release_info);
+			return false;
+		}
+
+		depth_swapchain_image = s_xr->depth_swapchain_images[swapchain_depth_image_index].image;
+	}
+
+	// Located after the swapchain waits, which can block, so the views are as recent as they can be before anything is drawn
+	XrViewLocateInfo view_locate_info{ .type = XR_TYPE_VIEW_LOCATE_INFO,
+										 .next = NULL,
+										 .viewConfigurationType = c_view_type,
+										 .displayTime = s_xr->frame_state.predictedDisplayTime,
+										 .space = s_xr->data.play_space };
+
+	XrViewState view_state{ XR_TYPE_VIEW_STATE };
+
+	uint32_t output_view_count;
+	result = xrLocateViews(s_xr->data.session, &view_locate_info, &view_state, c_view_count, &output_view_count, s_xr->views.data());
+	XrSpaceLocation view_location{ XR_TYPE_SPACE_LOCATION };
+	if (!xr_check(result, "Could not locate views") ||
+		!xr_check(locate_space_cached(s_xr->data.view_space, s_xr->data.play_space, s_xr->frame_state.predictedDisplayTime, &view_location), "Could not locate view location"))
+	{
+		release_swapchain_images();
+		return false;
+	}
+
+	assert(output_view_count == c_view_count);
+
+	for (int i = 0; i < c_view_count; ++i)
+	{
+		s_xr->projection_views[i].pose = s_xr->views[i].pose;
+		s_xr->projection_views[i].fov = s_xr->views[i].fov;
+	}
+
+	// Prebuilt with both images attached, see create_swapchain_framebuffers()
+	s_xr->fbo = s_xr->swapchain_fbos[swapchain_fbo_index(swapchain_image_index, swapchain_depth_image_index)];
+	s_xr->color_image_index = swapchain_image_index;
+	s_xr->depth_image_index = swapchain_depth_image_index;
+	
+	if (s_config.flags & RLOPENXR_FLAG_DYNAMIC_RESOLUTION)
+	{
+		update_resolution_scale();
+		update_view_rects();
+	}
+
+	// rlgl splits the render texture width between the eyes, so the render texture is sized to the current view rects.
+	// With multiview every eye gets the full viewport of its own layer.
+	const XrExtent2Di view_extent = scaled_view_extent();
+	const int render_texture_width = view_extent.width * (s_xr->multiview ? 1 : c_view_count);
+	const int render_texture_height = view_extent.height;
+
+	RenderTexture2D render_texture{
+		s_xr->fbo,
+		Texture2D{
+			color_swapchain_image,
+			render_texture_width,
+			render_texture_height,
+			1,
+			-1 // HACK: I do not know the GL format to RL format, but it doesn't seem to be used.
+		},
+		Texture2D{
+			depth_swapchain_image,
+			render_texture_width,
+			render_texture_height,
+			1,
+			-1 // HACK: I do not know the GL format to RL format, but it doesn't seem to be used.
+		}
+	};
+
+	BeginTextureMode(render_texture);
+	s_xr->active_fbo = s_xr->fbo;
+	s_xr->frame_rendered = true;
+
+	// Blended over a background layer by its alpha, which has to be premultiplied like the layers, see rlOpenXRBeginLayer()
+	if (has_background_layer())
+	{
+		glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	if (s_xr->multiview)
+	{
+		// rlgl's batched draws only get the MVP, they are assumed to be made in BeginMode3D() with the camera of rlOpenXRUpdateCamera()
+		const float aspect = (float)render_texture_width / render_texture_height;
+		s_xr->multiview_projection = Matrix{};
+		multiview_set_projection(camera_projection_matrix(aspect));
+
+		const Two<Matrix> corrections = multiview_corrections(view_location.pose);
+		for (int view = 0; view < c_view_count; ++view)
+		{
+			SetShaderValueMatrix(s_xr->multiview_shader, s_xr->multiview_correction_locs[view], corrections[view]);
+		}
+
+		rlSetShader(s_xr->multiview_shader.id, s_xr->multiview_shader.locs);
+	}
+	else
+	{
+		rlEnableStereoRender();
+
+		Two<Matrix> projections, view_offsets;
+		stereo_matrices(view_location.pose, &projections, &view_offsets);
+		rlSetMatrixProjectionStereo(projections[0], projections[1]);
+		rlSetMatrixViewOffsetStereo(view_offsets[0], view_offsets[1]);
+	}
+
+	gpu_timers_begin_frame();
+
+	return true;
+}
+
+bool rlOpenXRBeginMockHMD()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+
+	VrDeviceInfo mock_device = {
+		// Oculus Rift CV1 parameters for simulator
+		.hResolution = 2160,                 // Horizontal resolution in pixels
+		.vResolution = 1200,                 // Vertical resolution in pixels
+		.hScreenSize = 0.133793f,            // Horizontal size in meters
+		.vScreenSize = 0.0669f,              // Vertical size in meters
+		.vScreenCenter = 0.04678f,           // Screen center in meters
+		.eyeToScreenDistance = 0.041f,       // Distance between eye and display in meters
+		.lensSeparationDistance = 0.07f,     // Lens separation distance in meters
+		.interpupillaryDistance = 0.07f,     // IPD (distance between pupils) in meters
+
+		// NOTE: CV1 uses fresnel-hybrid-asymmetric lenses with specific compute shaders
+		// Following parameters are just an approximation to CV1 distortion stereo rendering
+		.lensDistortionValues = { 1.0f, 0.22f, 0.24f, 0.0f},
+		.chromaAbCorrection = { 0.996f,	-0.004f, 1.014f, 0.0f }
+	};
+
+	static const VrStereoConfig config = LoadVrStereoConfig(mock_device);
+
+	if (s_xr->mock_hmd_rt.id == 0)
+	{
+		s_xr->mock_hmd_rt = LoadRenderTexture(mock_device.hResolution, mock_device.vResolution);
+	}
+
+	BeginTextureMode(s_xr->mock_hmd_rt);
+	s_xr->active_fbo = s_xr->mock_hmd_rt.id;
+
+	BeginVrStereoMode(config);
+
+	return true;
+}
+
+void rlOpenXREnd()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+
+	if (s_xr->mock_hmd_rt.id != 0 && s_xr->active_fbo == s_xr->mock_hmd_rt.id)
+	{
+		EndVrStereoMode();
+		EndTextureMode();
+		s_xr->active_fbo = 0;
+	}
+
+	if (!s_xr->session_running || !s_xr->frame_begun)
+	{
+		return;
+	}
+	s_xr->frame_begun = false;
+
+	const bool rendered = s_xr->frame_rendered;
+	s_xr->frame_rendered = false;
+
+	if (rendered)
+	{
+		EndTextureMode();
+		s_xr->active_fbo = 0;
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // See rlOpenXRBegin()
+
+		gpu_timers_end_frame();
+
+		rlDisableStereoRender();
+		if (s_xr->multiview)
+		{
+			rlSetShader(rlGetShaderIdDefault(), rlGetShaderLocsDefault());
+		}
+
+		// Reads the eye depth, so it has to be rendered before the depth image is released
+		const bool space_warp = s_xr->space_warp.active && space_warp_render(s_xr->depth_swapchain_images[s_xr->depth_image_index].image);
+		chain_projection_views(space_warp);
+
+		release_swapchain_images(); // We still want to continue ending the xr frame
+	}
+
+	// Nothing was rendered when the runtime asked to skip rendering or rlOpenXRBegin() failed after xrBeginFrame(),
+	// the frame is still ended, but without layers
+	if (rendered)
+	{
+		update_layers_pointers();
+	}
+	else
+	{
+		s_xr->layers_pointers.clear();
+	}
+
+	XrFrameEndInfo frame_end_info = { .type = XR_TYPE_FRAME_END_INFO,
+									   .next = NULL,
+									   .displayTime = s_xr->frame_state.predictedDisplayTime,
+									   .environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE,
+									   .layerCount = (uint32_t)s_xr->layers_pointers.size(),
+									   .layers = s_xr->layers_pointers.data() };
+
+	XrResult result = xrEndFrame(s_xr->data.session, &frame_end_info);
+
+	if (s_xr->frame_stats.begin_time_ns != 0)
+	{
+		s_xr->frame_stats.pending.begin_to_end_ns = steady_time_ns() - s_xr->frame_stats.begin_time_ns;
+		s_xr->frame_stats.begin_time_ns = 0;
+	}
+
+	if (!xr_check(result, "failed to end frame!"))
+	{
+		return;
+	}
+}
+
+void rlOpenXRSetSpaceWarpActive(bool active)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+
+	if (active && !s_xr->space_warp.loaded)
+	{
+		RLOPENXR_LOG_WARNING("rlOpenXR: SpaceWarp is not available, set RLOPENXR_FLAG_SPACE_WARP and check the log of rlOpenXRSetup()");
+		return;
+	}
+
+	// The previous view projections are stale once frames were submitted without motion vectors
+	if (active && !s_xr->space_warp.active)
+	{
+		s_xr->space_warp.has_previous = false;
+	}
+	s_xr->space_warp.active = active;
+}
+
+bool rlOpenXRIsSpaceWarpActive()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+
+	return s_xr->space_warp.active;
+}
+
+int rlOpenXRCreateQuadLayer(int width, int height, RLOpenXRLayerSpace space, bool static_image)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(width > 0 && height > 0);
+
+	const int index = create_layer(width, height, static_image);
+	if (index < 0)
+	{
+		return -1;
+	}
+
+	RLOpenXRLayer& layer = s_xr->layers[index];
+	layer.quad = XrCompositionLayerQuad{
+		.type = XR_TYPE_COMPOSITION_LAYER_QUAD,
+		.next = nullptr,
+		.layerFlags = c_layer_flags,
+		.space = layer_space(space),
+		.eyeVisibility = XR_EYE_VISIBILITY_BOTH,
+		.subImage = layer_sub_image(layer),
+		.pose = layer_pose(Vector3{ 0.f, 0.f, -1.f }, QuaternionIdentity()),
+		.size = { 1.f, (float)height / width }
+	};
+
+	return index;
+}
+
+void rlOpenXRSetQuadLayerPose(int layer, Vector3 position, Quaternion orientation, Vector2 size)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(layer >= 0 && layer < (int)s_xr->layers.size() && s_xr->layers[layer].header.type == XR_TYPE_COMPOSITION_LAYER_QUAD);
+
+	XrCompositionLayerQuad& quad = s_xr->layers[layer].quad;
+	quad.pose = layer_pose(position, orientation);
+	quad.size = XrExtent2Df{ size.x, size.y };
+}
+
+int rlOpenXRCreateCylinderLayer(int width, int height, RLOpenXRLayerSpace space, bool static_image)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(width > 0 && height > 0);
+
+	if (!s_xr->extensions.cylinder_enabled)
+	{
+		RLOPENXR_LOG_WARNING("Runtime does not support XR_KHR_composition_layer_cylinder, no cylinder layer is created");
+		return -1;
+	}
+
+	const int index = create_layer(width, height, static_image);
+	if (index < 0)
+	{
+		return -1;
+	}
+
+	// A quarter of a cylinder 1m around the space origin, with the image's aspect ratio
+	RLOpenXRLayer& layer = s_xr->layers[index];
+	layer.cylinder = XrCompositionLayerCylinderKHR{
+		.type = XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR,
+		.next = nullptr,
+		.layerFlags = c_layer_flags,
+		.space = layer_space(space),
+		.eyeVisibility = XR_EYE_VISIBILITY_BOTH,
+		.subImage = layer_sub_image(layer),
+		.pose = layer_pose(Vector3Zero(), QuaternionIdentity()),
+		.radius = 1.f,
+		.centralAngle = PI / 2.f,
+		.aspectRatio = (float)width / height
+	};
+
+	return index;
+}
+
+void rlOpenXRSetCylinderLayer(int layer, Vector3 position, Quaternion orientation, float radius, float central_angle, float aspect_ratio)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(layer >= 0 && layer < (int)s_xr->layers.size() && s_xr->layers[layer].header.type == XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR);
+
+	XrCompositionLayerCylinderKHR& cylinder = s_xr->layers[layer].cylinder;
+	cylinder.pose = layer_pose(position, orientation);
+	cylinder.radius = radius;
+	cylinder.centralAngle = central_angle;
+	cylinder.aspectRatio = aspect_ratio;
+}
+
+int rlOpenXRCreateEquirectLayer(int width, int height, bool static_image)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(width > 0 && height > 0);
+
+	if (!s_xr->extensions.equirect2_enabled)
+	{
+		RLOPENXR_LOG_WARNING("Runtime does not support XR_KHR_composition_layer_equirect2, no equirect layer is created");
+		return -1;
+	}
+
+	const int index = create_layer(width, height, static_image);
+	if (index < 0)
+	{
+		return -1;
+	}
+
+	// Full sphere at infinity, so only the orientation of the play space matters
+	RLOpenXRLayer& layer = s_xr->layers[index];
+	layer.background = true;
+	layer.equirect2 = XrCompositionLayerEquirect2KHR{
+		.type = XR_TYPE_COMPOSITION_LAYER_EQUIRECT2_KHR,
+		.next = nullptr,
+		.layerFlags = c_layer_flags,
+		.space = s_xr->data.play_space,
+		.eyeVisibility = XR_EYE_VISIBILITY_BOTH,
+		.subImage = layer_sub_image(layer),
+		.pose = layer_pose(Vector3Zero(), QuaternionIdentity()),
+		.radius = 0.f,
+		.centralHorizontalAngle = 2.f * PI,
+		.upperVerticalAngle = PI / 2.f,
+		.lowerVerticalAngle = -PI / 2.f
+	};
+
+	return index;
+}
+
+void rlOpenXRSetEquirectLayer(int layer, Vector3 position, Quaternion orientation, float radius, float central_horizontal_angle, float upper_vertical_angle, float lower_vertical_angle)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(layer >= 0 && layer < (int)s_xr->layers.size() && s_xr->layers[layer].header.type == XR_TYPE_COMPOSITION_LAYER_EQUIRECT2_KHR);
+
+	XrCompositionLayerEquirect2KHR& equirect2 = s_xr->layers[layer].equirect2;
+	equirect2.pose = layer_pose(position, orientation);
+	equirect2.radius = radius;
+	equirect2.centralHorizontalAngle = central_horizontal_angle;
+	equirect2.upperVerticalAngle = upper_vertical_angle;
+	equirect2.lowerVerticalAngle = lower_vertical_angle;
+}
+
+void rlOpenXRSetLayerVisible(int layer, bool visible)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(layer >= 0 && layer < (int)s_xr->layers.size() && s_xr->layers[layer].swapchain != XR_NULL_HANDLE);
+
+	s_xr->layers[layer].visible = visible;
+}
+
+void rlOpenXRMarkLayerDirty(int layer)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(layer >= 0 && layer < (int)s_xr->layers.size() && s_xr->layers[layer].swapchain != XR_NULL_HANDLE);
+
+	if (s_xr->layers[layer].static_image && s_xr->layers[layer].has_image)
+	{
+		RLOPENXR_LOG_WARNING("Layer %d has a static image that is already drawn, it can not be redrawn", layer);
+		return;
+	}
+
+	s_xr->layers[layer].dirty = true;
+}
+
+bool rlOpenXRBeginLayer(int layer_index)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(layer_index >= 0 && layer_index < (int)s_xr->layers.size() && s_xr->layers[layer_index].swapchain != XR_NULL_HANDLE);
+	assert(s_xr->active_fbo == 0 && "Layers are drawn outside of rlOpenXRBegin() / rlOpenXREnd()");
+
+	RLOpenXRLayer& layer = s_xr->layers[layer_index];
+	if (!layer.dirty)
+	{
+		return false;
+	}
+
+	uint32_t image_index = 0;
+	XrSwapchainImageAcquireInfo acquire_info{ XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO };
+	XrResult result = xrAcquireSwapchainImage(layer.swapchain, &acquire_info, &image_index);
+	if (!xr_check(result, "failed to aquire layer %d swapchain image!", layer_index))
+		return false;
+
+	XrSwapchainImageWaitInfo wait_info{ XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
+	wait_info.timeout = XR_INFINITE_DURATION;
+	result = xrWaitSwapchainImage(layer.swapchain, &wait_info);
+	if (!xr_check(result, "failed to wait for layer %d swapchain image!", layer_index))
+		return false;
+
+	RenderTexture2D render_texture{
+		layer.fbos[image_index],
+		Texture2D{ layer.swapchain_images[image_index].image, layer.width, layer.height, 1, -1 },
+		Texture2D{ 0 }
+	};
+
+	BeginTextureMode(render_texture);
+	s_xr->active_fbo = render_texture.id;
+	s_xr->active_layer = layer_index;
+
+	// raylib's BLEND_ALPHA blends the alpha channel like the color, so the image would hold alpha squared and unpremultiplied color.
+	// BeginTextureMode() flushed the batch, and rlgl doesn't set the blend function again until the blend mode changes.
+	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+	return true;
+}
+
+void rlOpenXREndLayer()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(s_xr->active_layer >= 0 && "rlOpenXREndLayer() without rlOpenXRBeginLayer()");
+
+	EndTextureMode();
+
+	// Back to what rlgl's BLEND_ALPHA set, see rlOpenXRBeginLayer()
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	RLOpenXRLayer& layer = s_xr->layers[s_xr->active_layer];
+	XrSwapchainImageReleaseInfo release_info{ XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
+	XrResult result = xrReleaseSwapchainImage(layer.swapchain, &release_info);
+	if (xr_check(result, "failed to release layer %d swapchain image!", s_xr->active_layer))
+	{
+		layer.dirty = false;
+		layer.has_image = true;
+	}
+
+	s_xr->active_fbo = 0;
+	s_xr->active_layer = -1;
+}
+
+void rlOpenXRDestroyLayer(int layer)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(layer >= 0 && layer < (int)s_xr->layers.size() && layer != s_xr->active_layer);
+
+	destroy_layer(s_xr->layers[layer]);
+}
+
+void rlOpenXRBlitToWindow(RLOpenXREye eye, bool keep_aspect_ratio)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(s_xr->active_fbo != 0 && "rlOpenXR is not currently drawing. call after rlOpenXRBegin() or rlOpenXRBeginMockHMD() and before rlOpenXREnd()");
+
+	// Follows the current resolution scale, see update_view_rects()
+	const XrExtent2Di view_extent = scaled_view_extent();
+
+	XrRect2Di src{};
+	if (eye == RLOPENXR_EYE_LEFT)
+	{
+		src.offset = { 0, 0 };
+		src.extent = view_extent;
+	}
+	else if (eye == RLOPENXR_EYE_RIGHT)
+	{
+		src.offset = { view_extent.width, 0 };
+		src.extent = view_extent;
+	}
+	else if (eye == RLOPENXR_EYE_BOTH)
+	{
+		src.offset = { 0, 0 };
+		src.extent = { view_extent.width * c_view_count, view_extent.height };
+	}
+	else { assert(false && "Unknown value for `eye`"); }
+
+	XrRect2Di dest{ {0, 0}, {rlGetFramebufferWidth(), rlGetFramebufferHeight()} };
+
+	if (keep_aspect_ratio)
+	{
+		const float src_aspect = (float)src.extent.width / src.extent.height;
+		const float dest_aspect = (float)dest.extent.width / dest.extent.height;
 
-			break;
+		if (src_aspect > dest_aspect)
+		{
+			dest.extent.height = (int32_t)(dest.extent.width / src_aspect);
 		}
-		default: printf("Unhandled event (type %d)\n", runtime_event.type);
+		else
+		{
+			dest.extent.width = (int32_t)(dest.extent.height * src_aspect);
 		}
-
-		runtime_event.type = XR_TYPE_EVENT_DATA_BUFFER;
-		poll_result = xrPollEvent(s_xr->data.instance, &runtime_event);
-	}
-	if (poll_result == XR_EVENT_UNAVAILABLE) {
-		// processed all events in the queue
-	}
-	else {
-		// TODO: Actually print the poll_result as a string...
-		printf("Failed to poll events!\n");
 	}
 
-	// Wait for OpenXR frame
-	if (s_xr->session_running)
+	rlDisableFramebuffer(); // Return to default frame buffer
+
+	ClearBackground(BLACK);
+
+	if (s_xr->multiview && s_xr->active_fbo == s_xr->fbo)
 	{
-		XrFrameWaitInfo frame_wait_info = { .type = XR_TYPE_FRAME_WAIT_INFO, .next = NULL };
-		result = xrWaitFrame(s_xr->data.session, &frame_wait_info, &s_xr->frame_state);
-		if (!xr_check(result, "xrWaitFrame() was not successful, skipping this frame"))
+		// Every eye is a layer of its own, read through the per layer framebuffers
+		const int first_view = (eye == RLOPENXR_EYE_RIGHT) ? 1 : 0;
+		const int view_count = (eye == RLOPENXR_EYE_BOTH) ? c_view_count : 1;
+		const int32_t dest_view_width = dest.extent.width / view_count;
+
+		for (int i = 0; i < view_count; ++i)
 		{
-			return;
+			const int32_t dest_x = dest.offset.x + i * dest_view_width;
+			glBlitNamedFramebuffer(s_xr->multiview_blit_fbos[s_xr->color_image_index][first_view + i], 0,
+				0, 0, view_extent.width, view_extent.height,
+				dest_x, dest.offset.y, dest_x + dest_view_width, dest.offset.y + dest.extent.height,
+				GL_COLOR_BUFFER_BIT, GL_LINEAR);
 		}
 	}
+	else
+	{
+		glBlitNamedFramebuffer(s_xr->active_fbo, 0,
+			src.offset.x, src.offset.y, src.offset.x + src.extent.width, src.offset.y + src.extent.height,
+			dest.offset.x, dest.offset.y, dest.offset.x + dest.extent.width, dest.offset.y + dest.extent.height,
+			GL_COLOR_BUFFER_BIT, GL_LINEAR);
+	}
+
+	rlEnableFramebuffer(s_xr->active_fbo);
 }
 
-void rlOpenXRUpdateCamera(Camera3D* camera)
+void rlOpenXRDrawMesh(Mesh mesh, Material material, Matrix transform)
 {
 	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
-	assert(camera != nullptr);
 
-	const XrTime time = rlOpenXRGetTime();
+	// Custom shaders are drawn as is, they have to handle stereo themselves
+	const bool default_shader = material.shader.id == rlGetShaderIdDefault();
 
-	XrSpaceLocation view_location{ XR_TYPE_SPACE_LOCATION };
-	XrResult result = xrLocateSpace(s_xr->data.view_space, s_xr->data.play_space, time, &view_location);
-	if (!xr_check(result, "Could not locate view location"))
+	if (default_shader && s_xr->multiview && s_xr->active_fbo == s_xr->fbo)
 	{
-		return;
+		// Whatever projection is current, eg. a camera other than the one passed to rlOpenXRUpdateCamera()
+		multiview_set_projection(rlGetMatrixProjection());
+		material.shader = s_xr->multiview_shader;
+		DrawMesh(mesh, material, transform);
+	}
+	else if (!rlIsStereoRenderEnabled() || !draw_mesh_instanced_stereo(mesh, material, transform))
+	{
+		// In rlgl's stereo mode DrawMesh() draws once per eye
+		DrawMesh(mesh, material, transform);
 	}
+}
 
-	if (view_location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)
+void rlOpenXRDrawModel(Model model, Vector3 position, float scale, Color tint)
+{
+	rlOpenXRDrawModelEx(model, position, Vector3{ 0.f, 1.f, 0.f }, 0.f, Vector3{ scale, scale, scale }, tint);
+}
+
+void rlOpenXRDrawModelEx(Model model, Vector3 position, Vector3 rotation_axis, float rotation_angle, Vector3 scale, Color tint)
+{
+	// Same transform as raylib's DrawModelEx()
+	const Matrix mat_scale = MatrixScale(scale.x, scale.y, scale.z);
+	const Matrix mat_rotation = MatrixRotate(rotation_axis, rotation_angle * DEG2RAD);
+	const Matrix mat_translation = MatrixTranslate(position.x, position.y, position.z);
+	draw_model(model, MatrixMultiply(MatrixMultiply(mat_scale, mat_rotation), mat_translation), tint);
+}
+
+void rlOpenXRGetSwapchainFormats(int64_t* color_format, int64_t* depth_format)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+
+	if (color_format != nullptr)
 	{
-		const auto& pos = view_location.pose.position;
-		camera->position = Vector3{ pos.x, pos.y, pos.z };
+		*color_format = s_xr->color_format;
 	}
-	if (view_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)
+	if (depth_format != nullptr)
 	{
-		const auto& rot = view_location.pose.orientation;
-		const auto forward = Vector3RotateByQuaternion(Vector3{ 0, 0, -1 }, Quaternion{ rot.x, rot.y, rot.z, rot.w });
-		const auto up = Vector3RotateByQuaternion(Vector3{ 0, 1, 0 }, Quaternion{ rot.x, rot.y, rot.z, rot.w });
-		camera->target = Vector3Add(camera->position, forward);
-		camera->up = up;
+		*depth_format = s_xr->depth_format;
 	}
 }
 
-void rlOpenXRUpdateCameraTransform(Transform* transform)
+Shader rlOpenXRGetMultiviewShader()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+
+	if (!s_xr->multiview)
+	{
+		return Shader{ 0, nullptr };
+	}
+	return s_xr->multiview_shader;
+}
+
+void rlOpenXRUpdateHands(RLHand* left, RLHand* right)
 {
 	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
-	assert(transform != nullptr);
+
+	assert(right->handedness == RLOPENXR_HAND_RIGHT);
 
 	const XrTime time = rlOpenXRGetTime();
 
-	XrSpaceLocation view_location{ XR_TYPE_SPACE_LOCATION };
-	XrResult result = xrLocateSpace(s_xr->data.view_space, s_xr->data.play_space, time, &view_location);
-	if (!xr_check(result, "Could not locate view location"))
+	std::array hands{ left, right };
+
+	for (int hand_index = 0; hand_index < RLOPENXR_HAND_COUNT; ++hand_index)
 	{
-		return;
+		auto& hand = hands[hand_index];
+		
+		if (hand == nullptr)
+		{
+			continue;
+		}
+
+		assert(hand->handedness == (RLOpenXRHandEnum)hand_index && 
+			"handedness is not initialised, or the left/right parameter to rlOpenXRUpdateHands are swapped");
+
+		if (QuaternionEquals(hand->orientation, Quaternion{ 0, 0, 0, 0 }))
+		{
+			// Fixup invalid identity values
+			hand->orientation = QuaternionIdentity(); 
+		}
+
+		hand->valid = false;
+
+		XrActionStateGetInfo get_info = { .type = XR_TYPE_ACTION_STATE_GET_INFO,
+											.next = NULL,
+											.action = hand->hand_pose_action,
+											.subactionPath = hand->hand_pose_subpath };
+
+		XrActionStatePose hand_pose_state{ XR_TYPE_ACTION_STATE_POSE };
+		XrResult result = xrGetActionStatePose(s_xr->data.session, &get_info, &hand_pose_state);
+		if (!xr_check(result, "failed to get hand %d action state pose!", hand_index))
+		{
+			continue;
+		}
+
+		hand->valid = hand_pose_state.isActive;
+
+		if (hand_pose_state.isActive)
+		{
+			XrSpaceLocation hand_location{ XR_TYPE_SPACE_LOCATION };
+			result = locate_space_cached(hand->hand_pose_space, s_xr->data.play_space, time, &hand_location);
+			if (!xr_check(result, "Could not retrieve hand %d location", hand_index))
+			{
+				continue;
+			}
+
+			auto& pose = hand_location.pose;
+
+			if (hand_location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)
+			{
+				hand->position = Vector3{ pose.position.x, pose.position.y, pose.position.z };
+			}
+			if (hand_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)
+			{
+				hand->orientation = Quaternion{ pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w };
+			}
+		}
 	}
+}
 
-	if (view_location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)
+bool rlOpenXRIsHandTrackingSupported()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	return s_xr->hand_trackers[RLOPENXR_HAND_LEFT] != XR_NULL_HANDLE || s_xr->hand_trackers[RLOPENXR_HAND_RIGHT] != XR_NULL_HANDLE;
+}
+
+bool rlOpenXRGetHandJoints(RLOpenXRHandEnum hand, RLOpenXRHandJoints* joints)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(hand >= 0 && hand < RLOPENXR_HAND_COUNT && joints != nullptr);
+
+	joints->active = false;
+
+	const XrHandTrackerEXT tracker = s_xr->hand_trackers[hand];
+	if (tracker == XR_NULL_HANDLE)
 	{
-		const auto& pos = view_location.pose.position;
-		transform->translation = Vector3{ pos.x, pos.y, pos.z };
+		return false;
 	}
-	if (view_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)
+
+	const XrHandJointsLocateInfoEXT locate_info{
+		.type = XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT,
+		.next = nullptr,
+		.baseSpace = s_xr->data.play_space,
+		.time = rlOpenXRGetTime()
+	};
+	std::array<XrHandJointLocationEXT, XR_HAND_JOINT_COUNT_EXT> joint_locations;
+	XrHandJointLocationsEXT locations{
+		.type = XR_TYPE_HAND_JOINT_LOCATIONS_EXT,
+		.next = nullptr,
+		.isActive = XR_FALSE,
+		.jointCount = XR_HAND_JOINT_COUNT_EXT,
+		.jointLocations = joint_locations.data()
+	};
+
+	XrResult result = s_xr->extensions.xrLocateHandJointsEXT(tracker, &locate_info, &locations);
+	if (!xr_check(result, "Failed to locate the joints of hand %d", (int)hand) || !locations.isActive)
 	{
-		const auto& rot = view_location.pose.orientation;
-		transform->rotation = Quaternion{ rot.x, rot.y, rot.z, rot.w };
+		return false;
+	}
+
+	joints->active = true;
+	for (int i = 0; i < XR_HAND_JOINT_COUNT_EXT; ++i)
+	{
+		const XrHandJointLocationEXT& location = joint_locations[i];
+		joints->joints[i] = RLOpenXRHandJoint{
+			Vector3{ location.pose.position.x, location.pose.position.y, location.pose.position.z },
+			Quaternion{ location.pose.orientation.x, location.pose.orientation.y, location.pose.orientation.z, location.pose.orientation.w },
+			location.radius
+		};
+		joints->location_flags[i] = location.locationFlags;
 	}
+	return true;
 }
 
-// ----------------------------------------------------------------------------
+void rlOpenXRGetHandJointMatrices(const RLOpenXRHandJoints* joints, Matrix* matrices)
+{
+	assert(joints != nullptr && matrices != nullptr);
+	hand_joint_matrices(joints->joints, matrices, RLOPENXR_HAND_JOINT_COUNT);
+}
 
-bool rlOpenXRBegin()
+bool rlOpenXRPollEvent(RLOpenXREvent* event)
 {
 	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(event != nullptr);
 
-	if (!s_xr->session_running)
+	auto& queue = s_xr->event_queue;
+
+	const uint32_t tail = queue.tail.load(std::memory_order_relaxed);
+	if (tail == queue.head.load(std::memory_order_acquire))
 	{
-		return false;
+		// Dropped events are reported once the events that did fit are read
+		const uint32_t dropped = queue.dropped.exchange(0, std::memory_order_relaxed);
+		if (dropped == 0)
+		{
+			return false;
+		}
+
+		*event = RLOpenXREvent{ .type = RLOPENXR_EVENT_EVENTS_LOST, .lost_event_count = dropped };
+		return true;
 	}
 
-	XrViewLocateInfo view_locate_info{ .type = XR_TYPE_VIEW_LOCATE_INFO,
-										 .next = NULL,
-										 .viewConfigurationType = c_view_type,
-										 .displayTime = s_xr->frame_state.predictedDisplayTime,
-										 .space = s_xr->data.play_space };
+	*event = queue.events[tail % c_event_queue_capacity];
+	queue.tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
 
-	XrViewState view_state{ XR_TYPE_VIEW_STATE };
+void rlOpenXRSetEventCallback(RLOpenXREventType type, RLOpenXREventCallback callback, void* user_data)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(type >= 0 && type < RLOPENXR_EVENT_TYPE_COUNT);
 
-	uint32_t output_view_count;
-	XrResult result = xrLocateViews(s_xr->data.session, &view_locate_info, &view_state, c_view_count, &output_view_count, s_xr->views.data());
-	if (!xr_check(result, "Could not locate views"))
-		return false;
+	s_xr->event_queue.callbacks[type] = callback;
+	s_xr->event_queue.callback_user_data[type] = user_data;
+}
 
-	assert(output_view_count == c_view_count);
+bool rlOpenXRIsControllerModelSupported()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	return s_xr->extensions.controller_model_enabled;
+}
 
-	for (int i = 0; i < c_view_count; ++i)
+bool rlOpenXRGetControllerModel(RLOpenXRHandEnum hand, Model* model)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(hand >= 0 && hand < RLOPENXR_HAND_COUNT && model != nullptr);
+
+	const XrControllerModelKeyMSFT key = s_xr->controller_model_keys[hand];
+	const RLOpenXRControllerModel* controller_model = key != XR_NULL_CONTROLLER_MODEL_KEY_MSFT ? find_controller_model(key) : nullptr;
+	if (controller_model == nullptr || !controller_model->ready)
 	{
-		s_xr->projection_views[i].pose = s_xr->views[i].pose;
-		s_xr->projection_views[i].fov = s_xr->views[i].fov;
+		return false;
 	}
 
-	XrSpaceLocation view_location{ XR_TYPE_SPACE_LOCATION };
-	result = xrLocateSpace(s_xr->data.view_space, s_xr->data.play_space, s_xr->frame_state.predictedDisplayTime, &view_location);
-	if (!xr_check(result, "Could not locate view location"))
-		return false;
+	*model = controller_model->model;
+	return true;
+}
 
-	XrFrameBeginInfo frame_begin_info = { XR_TYPE_FRAME_BEGIN_INFO };
-	result = xrBeginFrame(s_xr->data.session, &frame_begin_info);
-	if (!xr_check(result, "failed to begin frame!"))
-		return false;
+bool rlOpenXRDrawControllerModel(const RLHand* hand, Color tint)
+{
+	assert(hand != nullptr);
 
-	if (!s_xr->run_framecycle)
+	Model model;
+	if (!hand->valid || !rlOpenXRGetControllerModel(hand->handedness, &model))
 	{
 		return false;
 	}
 
-	uint32_t swapchain_image_index = std::numeric_limits<uint32_t>::max();
-	XrSwapchainImageAcquireInfo color_swapchain_image_acquire_info{ XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO };
-	result = xrAcquireSwapchainImage(s_xr->swapchain, &color_swapchain_image_acquire_info, &swapchain_image_index);
-	if (!xr_check(result, "failed to aquire swapchain image!"))
-		return false;
-	XrSwapchainImageWaitInfo wait_info{ XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
-	wait_info.timeout = XR_INFINITE_DURATION;
-	result = xrWaitSwapchainImage(s_xr->swapchain, &wait_info);
-	if (!xr_check(result, "failed to wait for swapchain image!"))
-		return false;
+	// Controller models are authored in the grip space of the controller
+	const Matrix transform = MatrixMultiply(QuaternionToMatrix(hand->orientation), MatrixTranslate(hand->position.x, hand->position.y, hand->position.z));
+	draw_model(model, transform, tint);
+	return true;
+}
 
-	uint32_t color_swapchain_image = s_xr->swapchain_images[swapchain_image_index].image;
-	uint32_t depth_swapchain_image = std::numeric_limits<uint32_t>::max();
+bool rlOpenXRLocateSpaces(const XrSpace* spaces, int count, XrTime time, RLOpenXRSpaceLocations* locations)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(spaces != nullptr && locations != nullptr && count >= 0);
 
-	rlFramebufferAttach(s_xr->fbo, color_swapchain_image, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+	// XR_KHR_locate_spaces requires spaceCount > 0
+	if (count <= 0)
+	{
+		return true;
+	}
 
-	if (s_xr->extensions.depth_enabled)
+	if (time == 0)
 	{
-		uint32_t swapchain_depth_image_index = std::numeric_limits<uint32_t>::max();
-		XrSwapchainImageAcquireInfo depth_swapchain_image_acquire_info{ XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO };
-		result = xrAcquireSwapchainImage(s_xr->depth_swapchain, &depth_swapchain_image_acquire_info, &swapchain_depth_image_index);
-		if (!xr_check(result, "failed to aquire swapchain depth image!"))
-			return false;
-		XrSwapchainImageWaitInfo depth_wait_info{ XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
-		depth_wait_info.timeout = XR_INFINITE_DURATION;
-		result = xrWaitSwapchainImage(s_xr->depth_swapchain, &depth_wait_info);
-		if (!xr_check(result, "failed to wait for swapchain depth image!"))
+		time = rlOpenXRGetTime();
+	}
+
+#ifdef XR_KHR_locate_spaces
+	if (s_xr->extensions.xrLocateSpacesKHR != nullptr)
+	{
+		s_xr->space_locations.resize(count, XrSpaceLocationDataKHR{});
+
+		const XrSpacesLocateInfoKHR locate_info{
+			.type = XR_TYPE_SPACES_LOCATE_INFO_KHR,
+			.next = nullptr,
+			.baseSpace = s_xr->data.play_space,
+			.time = time,
+			.spaceCount = (uint32_t)count,
+			.spaces = spaces
+		};
+		XrSpaceLocationsKHR space_locations{
+			.type = XR_TYPE_SPACE_LOCATIONS_KHR,
+			.next = nullptr,
+			.locationCount = (uint32_t)count,
+			.locations = s_xr->space_locations.data()
+		};
+
+		const XrResult result = s_xr->extensions.xrLocateSpacesKHR(s_xr->data.session, &locate_info, &space_locations);
+		if (!xr_check(result, "Failed to locate %d spaces", count))
+		{
 			return false;
+		}
 
-		depth_swapchain_image = s_xr->depth_swapchain_images[swapchain_depth_image_index].image;
-		rlFramebufferAttach(s_xr->fbo, depth_swapchain_image, RL_ATTACHMENT_DEPTH, RL_ATTACHMENT_TEXTURE2D, 0); //TODO: Stencil
+		for (int i = 0; i < count; ++i)
+		{
+			store_space_location(locations, i, s_xr->space_locations[i].locationFlags, s_xr->space_locations[i].pose);
+		}
+		return true;
 	}
+#endif
 
-	assert(rlFramebufferComplete(s_xr->fbo));
-	
-	const int render_texture_width = s_xr->viewconfig_views[0].recommendedImageRectWidth * 2;
-	const int render_texture_height = s_xr->viewconfig_views[0].recommendedImageRectHeight;
-
-	RenderTexture2D render_texture{
-		s_xr->fbo,
-		Texture2D{
-			color_swapchain_image,
-			render_texture_width,
-			render_texture_height,
-			1,
-			-1 // HACK: I do not know the GL format to RL format, but it doesn't seem to be used.
-		},
-		Texture2D{
-			depth_swapchain_image,
-			render_texture_width,
-			render_texture_height,
-			1,
-			-1 // HACK: I do not know the GL format to RL format, but it doesn't seem to be used.
+	bool success = true;
+	for (int i = 0; i < count; ++i)
+	{
+		XrSpaceLocation location{ XR_TYPE_SPACE_LOCATION };
+		const XrResult result = locate_space_cached(spaces[i], s_xr->data.play_space, time, &location);
+		if (!xr_check(result, "Failed to locate space %d", i))
+		{
+			success = false;
+			location.locationFlags = 0;
+			location.pose = identity_pose;
 		}
+		store_space_location(locations, i, location.locationFlags, location.pose);
+	}
+	return success;
+}
+
+void rlOpenXRSyncSingleActionSet(XrActionSet action_set)
+{
+	const XrActiveActionSet active_actionsets[1] = { { action_set, XR_NULL_PATH} };
+
+	XrActionsSyncInfo actions_sync_info = {
+			 XR_TYPE_ACTIONS_SYNC_INFO, NULL,
+			 sizeof(active_actionsets) / sizeof(active_actionsets[0]),
+			active_actionsets
 	};
+	XrResult result = xrSyncActions(s_xr->data.session, &actions_sync_info);
+	xr_check(result, "failed to sync actions!");
+}
 
-	BeginTextureMode(render_texture);
-	s_xr->active_fbo = s_xr->fbo;
+XrPath rlOpenXRPath(const char* path)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(path != nullptr);
+	auto& table = s_xr->path_table;
 
-	rlEnableStereoRender();
-	
-	auto proj_left = xr_projection_matrix(s_xr->views[0].fov);
-	auto proj_right = xr_projection_matrix(s_xr->views[1].fov);
-	std::swap(proj_left, proj_right); // For some reason it doesn't look right unless they are swapped!?
-	rlSetMatrixProjectionStereo(proj_right, proj_left); 
+	const auto found = table.paths.find(std::string_view(path));
+	if (found != table.paths.end())
+	{
+		return found->second;
+	}
 
-	const auto view_matrix = MatrixInvert(xr_matrix(view_location.pose));
-	const auto view_offset_left = MatrixMultiply(xr_matrix(s_xr->views[0].pose), view_matrix);
-	const auto view_offset_right = MatrixMultiply(xr_matrix(s_xr->views[1].pose), view_matrix);
-	rlSetMatrixViewOffsetStereo(view_offset_right, view_offset_left);
+	XrPath xr_path = XR_NULL_PATH;
+	XrResult result = xrStringToPath(s_xr->data.instance, path, &xr_path);
+	if (!xr_check(result, "Failed to convert '%s' to a path", path))
+	{
+		return XR_NULL_PATH;
+	}
 
-	return true;
+	table.paths.emplace(path, xr_path);
+	table.strings.emplace(xr_path, path);
+	return xr_path;
 }
 
-bool rlOpenXRBeginMockHMD()
+const char* rlOpenXRPathString(XrPath path)
 {
 	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	auto& table = s_xr->path_table;
 
-	VrDeviceInfo mock_device = {
-		// Oculus Rift CV1 parameters for simulator
-		.hResolution = 2160,                 // Horizontal resolution in pixels
-		.vResolution = 1200,                 // Vertical resolution in pixels
-		.hScreenSize = 0.133793f,            // Horizontal size in meters
-		.vScreenSize = 0.0669f,              // Vertical size in meters
-		.vScreenCenter = 0.04678f,           // Screen center in meters
-		.eyeToScreenDistance = 0.041f,       // Distance between eye and display in meters
-		.lensSeparationDistance = 0.07f,     // Lens separation distance in meters
-		.interpupillaryDistance = 0.07f,     // IPD (distance between pupils) in meters
-
-		// NOTE: CV1 uses fresnel-hybrid-asymmetric lenses with specific compute shaders
-		// Following parameters are just an approximation to CV1 distortion stereo rendering
-		.lensDistortionValues = { 1.0f, 0.22f, 0.24f, 0.0f},
-		.chromaAbCorrection = { 0.996f,	-0.004f, 1.014f, 0.0f }
-	};
+	const auto found = table.strings.find(path);
+	if (found != table.strings.end())
+	{
+		return found->second.c_str();
+	}
 
-	static const VrStereoConfig config = LoadVrStereoConfig(mock_device);
+	// Paths can come from the runtime too, eg the current interaction profile
+	uint32_t size = 0;
+	XrResult result = xrPathToString(s_xr->data.instance, path, 0, &size, nullptr);
+	if (!xr_check(result, "Failed to get the length of path %llu", (unsigned long long)path))
+	{
+		return nullptr;
+	}
 
-	if (s_xr->mock_hmd_rt.id == 0)
+	std::string string(size, '\0');
+	result = xrPathToString(s_xr->data.instance, path, size, &size, string.data());
+	if (!xr_check(result, "Failed to convert path %llu to a string", (unsigned long long)path))
 	{
-		s_xr->mock_hmd_rt = LoadRenderTexture(mock_device.hResolution, mock_device.vResolution);
+		return nullptr;
 	}
+	string.resize(size > 0 ? size - 1 : 0); // Without the null terminator
 
-	BeginTextureMode(s_xr->mock_hmd_rt);
-	s_xr->active_fbo = s_xr->mock_hmd_rt.id;
+	table.paths.emplace(string, path);
+	return table.strings.emplace(path, std::move(string)).first->second.c_str();
+}
 
-	BeginVrStereoMode(config);
+int rlOpenXRCreateActionSet(const char* name, const char* localized_name, unsigned int priority)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(name != nullptr && localized_name != nullptr);
+	auto& manager = s_xr->action_manager;
+	assert(!manager.attached && "Action sets can not be created after rlOpenXRAttachActionSets()");
 
-	return true;
+	XrActionSetCreateInfo create_info{ .type = XR_TYPE_ACTION_SET_CREATE_INFO, .next = nullptr, .priority = priority };
+	snprintf(create_info.actionSetName, XR_MAX_ACTION_SET_NAME_SIZE, "%s", name);
+	snprintf(create_info.localizedActionSetName, XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE, "%s", localized_name);
+
+	RLOpenXRManagedActionSet set;
+	XrResult result = xrCreateActionSet(s_xr->data.instance, &create_info, &set.handle);
+	if (!xr_check(result, "Failed to create action set '%s'", name))
+	{
+		return -1;
+	}
+
+	manager.sets.push_back(set);
+	return (int)manager.sets.size() - 1;
 }
 
-void rlOpenXREnd()
+int rlOpenXRCreateAction(int action_set, const char* name, const char* localized_name, XrActionType type, bool per_hand)
 {
 	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(name != nullptr && localized_name != nullptr);
+	auto& manager = s_xr->action_manager;
+	assert(action_set >= 0 && action_set < (int)manager.sets.size() && "Unknown action set");
+	assert(!manager.attached && "Actions can not be created after rlOpenXRAttachActionSets()");
 
-	if (!s_xr->session_running)
+	if (per_hand && manager.hand_paths[RLOPENXR_HAND_LEFT] == XR_NULL_PATH)
 	{
-		return;
+		for (int hand = 0; hand < RLOPENXR_HAND_COUNT; ++hand)
+		{
+			manager.hand_paths[hand] = rlOpenXRPath(c_hand_paths[hand]);
+			if (manager.hand_paths[hand] == XR_NULL_PATH)
+			{
+				return -1;
+			}
+		}
 	}
 
-	if (s_xr->run_framecycle)
-	{
-		EndTextureMode();
-		s_xr->active_fbo = 0;
+	XrActionCreateInfo create_info{
+		.type = XR_TYPE_ACTION_CREATE_INFO,
+		.next = nullptr,
+		.actionType = type,
+		.countSubactionPaths = per_hand ? (uint32_t)RLOPENXR_HAND_COUNT : 0,
+		.subactionPaths = per_hand ? manager.hand_paths.data() : nullptr
+	};
+	snprintf(create_info.actionName, XR_MAX_ACTION_NAME_SIZE, "%s", name);
+	snprintf(create_info.localizedActionName, XR_MAX_LOCALIZED_ACTION_NAME_SIZE, "%s", localized_name);
 
-		rlDisableStereoRender();
+	RLOpenXRManagedAction action;
+	action.type = type;
+	action.action_set = action_set;
+	action.subaction_count = per_hand ? RLOPENXR_HAND_COUNT : 1;
+	action.state_offset = (int)manager.states.size();
 
-		XrSwapchainImageReleaseInfo release_info{ XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
-		XrResult result = xrReleaseSwapchainImage(s_xr->swapchain, &release_info);
-		xr_check(result, "failed to release color swapchain image!"); // We still want to continue ending the xr frame
+	XrResult result = xrCreateAction(manager.sets[action_set].handle, &create_info, &action.handle);
+	if (!xr_check(result, "Failed to create action '%s'", name))
+	{
+		return -1;
+	}
 
-		if (s_xr->extensions.depth_enabled)
+	// Poses can't be queried directly, they are located through an action space per subaction
+	if (type == XR_ACTION_TYPE_POSE_INPUT)
+	{
+		for (int subaction = 0; subaction < action.subaction_count; ++subaction)
 		{
-			XrSwapchainImageReleaseInfo depth_release_info{ XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
-			result = xrReleaseSwapchainImage(s_xr->depth_swapchain, &depth_release_info);
-			xr_check(result, "failed to release depth swapchain image!"); // We still want to continue ending the xr frame
+			const XrActionSpaceCreateInfo space_info{
+				.type = XR_TYPE_ACTION_SPACE_CREATE_INFO,
+				.next = nullptr,
+				.action = action.handle,
+				.subactionPath = per_hand ? manager.hand_paths[subaction] : XR_NULL_PATH,
+				.poseInActionSpace = identity_pose
+			};
+			result = xrCreateActionSpace(s_xr->data.session, &space_info, &action.spaces[subaction]);
+			if (!xr_check(result, "Failed to create the action space of '%s'", name))
+			{
+				return -1;
+			}
 		}
 	}
 
-	XrFrameEndInfo frame_end_info = { .type = XR_TYPE_FRAME_END_INFO,
-									   .next = NULL,
-									   .displayTime = s_xr->frame_state.predictedDisplayTime,
-									   .environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE,
-									   .layerCount = (uint32_t)s_xr->layers_pointers.size(),
-									   .layers = s_xr->layers_pointers.data() };
+	manager.states.resize(manager.states.size() + action.subaction_count, RLOpenXRActionState{ .orientation = { 0.f, 0.f, 0.f, 1.f } });
+	manager.actions.push_back(action);
+	return (int)manager.actions.size() - 1;
+}
 
-	XrResult result = xrEndFrame(s_xr->data.session, &frame_end_info);
-	if (!xr_check(result, "failed to end frame!"))
+bool rlOpenXRSuggestActionBinding(int action, const char* interaction_profile, const char* binding)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	auto& manager = s_xr->action_manager;
+	assert(action >= 0 && action < (int)manager.actions.size() && "Unknown action");
+	assert(!manager.attached && "Bindings can not be suggested after rlOpenXRAttachActionSets()");
+
+	const XrPath profile_path = rlOpenXRPath(interaction_profile);
+	const XrPath binding_path = rlOpenXRPath(binding);
+	if (profile_path == XR_NULL_PATH || binding_path == XR_NULL_PATH)
 	{
-		return;
+		return false;
 	}
+
+	manager.suggested_bindings.push_back({ profile_path, XrActionSuggestedBinding{ manager.actions[action].handle, binding_path } });
+	return true;
 }
 
-void rlOpenXRBlitToWindow(RLOpenXREye eye, bool keep_aspect_ratio)
+bool rlOpenXRAttachActionSets()
 {
 	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
-	assert(s_xr->active_fbo != 0 && "rlOpenXR is not currently drawing. call after rlOpenXRBegin() or rlOpenXRBeginMockHMD() and before rlOpenXREnd()");
+	auto& manager = s_xr->action_manager;
+	assert(!manager.attached && "rlOpenXRAttachActionSets() can only be called once");
 
-	XrRect2Di src{};
-	if (eye == RLOPENXR_EYE_LEFT)
+	// xrSuggestInteractionProfileBindings() replaces earlier suggestions for a profile, so every profile is submitted once with all of its bindings
+	std::stable_sort(manager.suggested_bindings.begin(), manager.suggested_bindings.end(), 
+		[](const auto& a, const auto& b) { return a.first < b.first; });
+
+	std::vector<XrActionSuggestedBinding> profile_bindings;
+	for (size_t begin = 0; begin < manager.suggested_bindings.size();)
 	{
-		src.offset = { 0, 0 };
-		src.extent.width = (int)s_xr->viewconfig_views[0].recommendedImageRectWidth;
-		src.extent.height = (int)s_xr->viewconfig_views[0].recommendedImageRectHeight;
+		const XrPath profile = manager.suggested_bindings[begin].first;
+
+		profile_bindings.clear();
+		size_t end = begin;
+		for (; end < manager.suggested_bindings.size() && manager.suggested_bindings[end].first == profile; ++end)
+		{
+			profile_bindings.push_back(manager.suggested_bindings[end].second);
+		}
+
+		const XrInteractionProfileSuggestedBinding suggested_bindings{
+			.type = XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING,
+			.next = nullptr,
+			.interactionProfile = profile,
+			.countSuggestedBindings = (uint32_t)profile_bindings.size(),
+			.suggestedBindings = profile_bindings.data()
+		};
+		XrResult result = xrSuggestInteractionProfileBindings(s_xr->data.instance, &suggested_bindings);
+		if (!xr_check(result, "Failed to suggest %d bindings for an interaction profile", (int)profile_bindings.size()))
+		{
+			return false;
+		}
+
+		begin = end;
 	}
-	else if (eye == RLOPENXR_EYE_RIGHT)
+	manager.suggested_bindings.clear();
+
+	std::vector<XrActionSet> handles;
+	for (const auto& set : manager.sets)
 	{
-		src.offset.x = (int)s_xr->viewconfig_views[0].recommendedImageRectWidth;
-		src.offset.y = (int)s_xr->viewconfig_views[0].recommendedImageRectHeight;
-		src.extent.width = (int)s_xr->viewconfig_views[1].recommendedImageRectWidth;
-		src.extent.height = (int)s_xr->viewconfig_views[1].recommendedImageRectHeight;
+		handles.push_back(set.handle);
 	}
-	else if (eye == RLOPENXR_EYE_BOTH)
+
+	const XrSessionActionSetsAttachInfo attach_info{
+		.type = XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO,
+		.next = nullptr,
+		.countActionSets = (uint32_t)handles.size(),
+		.actionSets = handles.data()
+	};
+	XrResult result = xrAttachSessionActionSets(s_xr->data.session, &attach_info);
+	if (!xr_check(result, "Failed to attach %d action sets", (int)handles.size()))
 	{
-		src.offset = { 0, 0 };
-		src.extent.width = (int)(s_xr->viewconfig_views[0].recommendedImageRectWidth + s_xr->viewconfig_views[1].recommendedImageRectWidth);
-		src.extent.height = (int)s_xr->viewconfig_views[0].recommendedImageRectHeight;
+		return false;
 	}
-	else { assert(false && "Unknown value for `eye`"); }
 
-	XrRect2Di dest{ {0, 0}, {rlGetFramebufferWidth(), rlGetFramebufferHeight()} };
+	manager.attached = true;
+	return true;
+}
 
-	if (keep_aspect_ratio)
-	{
-		const float src_aspect = (float)src.extent.width / src.extent.height;
-		const float dest_aspect = (float)dest.extent.width / dest.extent.height;
+void rlOpenXRSetActionSetActive(int action_set, bool active)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(action_set >= 0 && action_set < (int)s_xr->action_manager.sets.size() && "Unknown action set");
 
-		if (src_aspect > dest_aspect)
-		{
-			dest.extent.height = (int32_t)(dest.extent.width / src_aspect);
-		}
-		else
-		{
-			dest.extent.width = (int32_t)(dest.extent.height * src_aspect);
-		}
-	}
+	s_xr->action_manager.sets[action_set].active = active;
+}
 
-	rlDisableFramebuffer(); // Return to default frame buffer
+const RLOpenXRActionState* rlOpenXRGetActionState(int action, RLOpenXRHandEnum hand)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	auto& manager = s_xr->action_manager;
+	assert(action >= 0 && action < (int)manager.actions.size() && "Unknown action");
 
-	ClearBackground(BLACK);
+	const RLOpenXRManagedAction& managed_action = manager.actions[action];
+	const int subaction = managed_action.subaction_count > 1 ? (int)hand : 0;
+	assert(subaction >= 0 && subaction < managed_action.subaction_count);
 
-	glBlitNamedFramebuffer(s_xr->active_fbo, 0,
-		src.offset.x, src.offset.y, src.offset.x + src.extent.width, src.offset.y + src.extent.height,
-		dest.offset.x, dest.offset.y, dest.offset.x + dest.extent.width, dest.offset.y + dest.extent.height,
-		GL_COLOR_BUFFER_BIT, GL_LINEAR);
+	return managed_action_state(managed_action, subaction);
+}
 
-	rlEnableFramebuffer(s_xr->active_fbo);
+XrAction rlOpenXRGetAction(int action)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(action >= 0 && action < (int)s_xr->action_manager.actions.size() && "Unknown action");
+
+	return s_xr->action_manager.actions[action].handle;
 }
 
-void rlOpenXRUpdateHands(RLHand* left, RLHand* right)
+void rlOpenXRSetHandPoseAction(RLHand* hand, int pose_action)
 {
 	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(hand != nullptr);
+	auto& manager = s_xr->action_manager;
+	assert(pose_action >= 0 && pose_action < (int)manager.actions.size() && "Unknown action");
 
-	assert(right->handedness == RLOPENXR_HAND_RIGHT);
+	const RLOpenXRManagedAction& action = manager.actions[pose_action];
+	assert(action.type == XR_ACTION_TYPE_POSE_INPUT && action.subaction_count == RLOPENXR_HAND_COUNT && "Expected a per hand pose action");
 
-	const XrTime time = rlOpenXRGetTime();
+	hand->hand_pose_action = action.handle;
+	hand->hand_pose_subpath = manager.hand_paths[hand->handedness];
+	hand->hand_pose_space = action.spaces[hand->handedness];
+}
 
-	std::array hands{ left, right };
+const RLOpenXRData* rlOpenXRData()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	return &s_xr->data;
+}
 
-	for (int hand_index = 0; hand_index < RLOPENXR_HAND_COUNT; ++hand_index)
-	{
-		auto& hand = hands[hand_index];
-		
-		if (hand == nullptr)
+void rlOpenXRGetFrameStats(RLOpenXRFrameStats* stats)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(stats != nullptr);
+
+	*stats = RLOpenXRFrameStats{};
+	stats->frame_count = s_xr->frame_stats.count;
+
+	int index = 0;
+	int delta_index = 0;
+	int should_render_count = 0;
+	frame_stats_for_each([&](const RLOpenXRFrameRecord& record) {
+		frame_stats_accumulate(stats->display_period_ms, record.predicted_display_period * 1e-6, index);
+		frame_stats_accumulate(stats->wait_frame_ms, record.wait_ns * 1e-6, index);
+		frame_stats_accumulate(stats->begin_to_end_ms, record.begin_to_end_ns * 1e-6, index);
+		++index;
+
+		should_render_count += record.should_render ? 1 : 0;
+
+		if (!record.has_display_time_delta)
 		{
-			continue;
+			return;
 		}
 
-		assert(hand->handedness == (RLOpenXRHandEnum)hand_index && 
-			"handedness is not initialised, or the left/right parameter to rlOpenXRUpdateHands are swapped");
+		frame_stats_accumulate(stats->display_time_delta_ms, record.display_time_delta * 1e-6, delta_index);
+		++delta_index;
 
-		if (QuaternionEquals(hand->orientation, Quaternion{ 0, 0, 0, 0 }))
+		// Every display period skipped is a frame the runtime had to fill in for us, or one shown twice
+		const double periods = record.predicted_display_period > 0 ? (double)record.display_time_delta / (double)record.predicted_display_period : 1.0;
+		if (periods >= 1.5)
 		{
-			// Fixup invalid identity values
-			hand->orientation = QuaternionIdentity(); 
+			stats->dropped_frames += (int)(periods + 0.5) - 1;
+		}
+		else if (periods < 0.5)
+		{
+			stats->repeated_frames++;
 		}
+	});
 
-		hand->valid = false;
+	stats->should_render_ratio = stats->frame_count > 0 ? (float)should_render_count / (float)stats->frame_count : 0.f;
+}
 
-		XrActionStateGetInfo get_info = { .type = XR_TYPE_ACTION_STATE_GET_INFO,
-											.next = NULL,
-											.action = hand->hand_pose_action,
-											.subactionPath = hand->hand_pose_subpath };
+void rlOpenXRGpuZoneBegin(const char* name)
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(name != nullptr);
 
-		XrActionStatePose hand_pose_state{ XR_TYPE_ACTION_STATE_POSE };
-		XrResult result = xrGetActionStatePose(s_xr->data.session, &get_info, &hand_pose_state);
-		if (!xr_check(result, "failed to get hand %d action state pose!", hand_index))
-		{
-			continue;
-		}
+	auto& timers = s_xr->gpu_timers;
+	RLOpenXRGpuTimerFrame* frame = timers.recording;
+	if (frame == nullptr || frame->zone_count == RLOPENXR_MAX_GPU_ZONES)
+	{
+		return; // Not rendering to the HMD, or out of zones
+	}
 
-		hand->valid = hand_pose_state.isActive;
+	const int zone_index = frame->zone_count++;
+	RLOpenXRGpuZone& zone = frame->zones[zone_index];
+	snprintf(zone.name, RLOPENXR_GPU_ZONE_NAME_SIZE, "%s", name);
+	zone.depth = timers.open_zone_count;
+	frame->zone_ended[zone_index] = false;
+	timers.open_zones[timers.open_zone_count++] = zone_index;
 
-		if (hand_pose_state.isActive)
-		{
-			XrSpaceLocation hand_location{ XR_TYPE_SPACE_LOCATION };
-			result = xrLocateSpace(hand->hand_pose_space, s_xr->data.play_space, time, &hand_location);
-			if (!xr_check(result, "Could not retrieve hand %d location", hand_index))
-			{
-				continue;
-			}
+	rlDrawRenderBatchActive(); // Batched draws from before the zone would otherwise be timed inside it
+	glQueryCounter(frame->zone_begin_queries[zone_index], GL_TIMESTAMP);
+}
 
-			auto& pose = hand_location.pose;
+void rlOpenXRGpuZoneEnd()
+{
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
 
-			if (hand_location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)
-			{
-				hand->position = Vector3{ pose.position.x, pose.position.y, pose.position.z };
-			}
-			if (hand_location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)
-			{
-				hand->orientation = Quaternion{ pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w };
-			}
-		}
+	auto& timers = s_xr->gpu_timers;
+	RLOpenXRGpuTimerFrame* frame = timers.recording;
+	if (frame == nullptr || timers.open_zone_count == 0)
+	{
+		return;
 	}
+
+	const int zone_index = timers.open_zones[--timers.open_zone_count];
+	frame->zone_ended[zone_index] = true;
+
+	rlDrawRenderBatchActive();
+	glQueryCounter(frame->zone_end_queries[zone_index], GL_TIMESTAMP);
 }
 
-void rlOpenXRSyncSingleActionSet(XrActionSet action_set)
+void rlOpenXRGetGpuTimings(RLOpenXRGpuTimings* timings)
 {
-	const XrActiveActionSet active_actionsets[1] = { { action_set, XR_NULL_PATH} };
+	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
+	assert(timings != nullptr);
 
-	XrActionsSyncInfo actions_sync_info = {
-			 XR_TYPE_ACTIONS_SYNC_INFO, NULL,
-			 sizeof(active_actionsets) / sizeof(active_actionsets[0]),
-			active_actionsets
-	};
-	XrResult result = xrSyncActions(s_xr->data.session, &actions_sync_info);
-	xr_check(result, "failed to sync actions!");
+	*timings = s_xr->gpu_timers.latest;
 }
 
-const RLOpenXRData* rlOpenXRData()
+void rlOpenXRSetResolutionScaleRange(float min_scale, float max_scale)
+{
+	assert(s_xr == nullptr && "The resolution scale range has to be set before rlOpenXRSetup()");
+	assert(min_scale > 0.f && min_scale <= max_scale);
+
+	s_config.resolution_scale_min = min_scale;
+	s_config.resolution_scale_max = max_scale;
+}
+
+float rlOpenXRGetResolutionScale()
 {
 	assert(s_xr && "rlOpenXR is not initialised yet, call rlOpenXRSetup()");
-	return &s_xr->data;
+	return s_xr->resolution_scale;
+}
+
+void rlOpenXRSetFrameStatsDumpPath(const char* path)
+{
+	s_config.frame_stats_dump_path = path != nullptr ? path : "";
+}
+
+void rlOpenXRSetLogLevel(RLOpenXRLogLevel level)
+{
+	s_log.level.store(level, std::memory_order_relaxed);
+}
+
+void rlOpenXRSetLogToTraceLog(bool enabled)
+{
+	s_log.to_trace_log.store(enabled, std::memory_order_relaxed);
+}
+
+void rlOpenXRSetIdleSleep(int milliseconds)
+{
+	s_config.idle_sleep_ms = std::max(milliseconds, 0);
+}
+
+void rlOpenXRSetControllerModelCacheDir(const char* path)
+{
+	assert(s_xr == nullptr && "The controller model cache has to be set before rlOpenXRSetup()");
+	s_config.controller_model_cache_dir = path != nullptr ? path : "";
 }
 
 XrTime rlOpenXRGetTime()
 {
+	// Sampled once per frame, so every pose of a frame is located at the same time
+	if (s_xr->frame_time != 0)
+	{
+		return s_xr->frame_time;
+	}
+
+#if defined(RLOPENXR_PLATFORM_WIN32)
 	const XrTime current_time = wrapped_XrTimeFromQueryPerformanceCounter(s_xr->data.instance, 
 		s_xr->extensions.xrConvertWin32PerformanceCounterToTimeKHR);
+#elif defined(RLOPENXR_PLATFORM_LINUX)
+	const XrTime current_time = wrapped_XrTimeFromTimespecMonotonic(s_xr->data.instance,
+		(void*)s_xr->extensions.xrConvertTimespecTimeToTimeKHR);
+#endif
 	const XrTime predicted_time = s_xr->frame_state.predictedDisplayTime;
 	
-	return std::max(current_time, predicted_time);
+	s_xr->frame_time = std::max(current_time, predicted_time);
+	return s_xr->frame_time;
 }
 
 #ifdef __cplusplus